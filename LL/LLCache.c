@@ -0,0 +1,143 @@
+#include "LLCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#pragma mark - Internal Helper Functions
+
+void _LLCacheAdmit(LLCache *cache, LLKey key)
+{
+  LinkNode *node = LLFindKeyed(cache->list, key);
+
+  /* A put over an existing key replaces it; that is not an eviction */
+  if (node)
+  {
+    LLRemoveNode(cache->list, node);
+    LNDelete(node);
+    cache->count--;
+  }
+}
+
+LinkNode *_LLCacheAdmitted(LLCache *cache, LinkNode *node)
+{
+  LinkNode *victim;
+
+  cache->count++;
+
+  while (cache->count > cache->capacity)
+  {
+    victim = LLDequeueNode(cache->list);
+    if (!victim) break;
+
+    cache->count--;
+    cache->stats.evictions++;
+
+    if (cache->onEvict) cache->onEvict(victim, cache->context);
+    LNDelete(victim);
+  }
+
+  return node;
+}
+
+#pragma mark - Creation Functions
+
+LLCache *LLCacheCreate(size_t capacity, LLCacheEvictFn onEvict, LLVoid context)
+{
+  LLCache *cache = (LLCache *)malloc(sizeof(LLCache));
+
+  if (!cache) return NULL;
+  memset(cache, 0L, sizeof(LLCache));
+
+  cache->list = LLCreate();
+  if (!cache->list || !LLEnableKeyIndex(cache->list, Yes))
+  {
+    if (cache->list) LLDelete(cache->list);
+    free(cache);
+    return NULL;
+  }
+
+  cache->capacity = capacity ? capacity : 1;
+  cache->onEvict = onEvict;
+  cache->context = context;
+  return cache;
+}
+
+#pragma mark - Deallocation Functions
+
+void LLCacheDelete(LLCache *cache)
+{
+  if (!cache) return;
+
+  LLDelete(cache->list);
+  free(cache);
+}
+
+#pragma mark - Lookup Functions
+
+LinkNode *LLCacheGet(LLCache *cache, LLKey key)
+{
+  LinkNode *node = LLFindKeyed(cache->list, key);
+
+  if (!node)
+  {
+    cache->stats.misses++;
+    return NULL;
+  }
+
+  cache->stats.hits++;
+  return LLMoveNodeToTail(cache->list, node);
+}
+
+LinkNode *LLCachePeek(LLCache *cache, LLKey key)
+{
+  return LLFindKeyed(cache->list, key);
+}
+
+LLBoolean LLCacheRemove(LLCache *cache, LLKey key)
+{
+  LinkNode *node = LLFindKeyed(cache->list, key);
+
+  if (!node) return No;
+
+  LLRemoveNode(cache->list, node);
+  LNDelete(node);
+  cache->count--;
+  return Yes;
+}
+
+void LLCacheGetStats(LLCache *cache, LLCacheStats *stats)
+{
+  memcpy(stats, &cache->stats, sizeof(LLCacheStats));
+}
+
+#pragma mark - Insertion Functions
+
+LinkNode *LLCachePutBoolean(LLCache *cache, LLKey key, LLBoolean boolean)
+{
+  _LLCacheAdmit(cache, key);
+  return _LLCacheAdmitted(cache, LLPushKeyedBoolean(cache->list, key, boolean));
+}
+
+LinkNode *LLCachePutInteger(LLCache *cache, LLKey key, MAX_INT_TYPE value, LLIntegerType type)
+{
+  _LLCacheAdmit(cache, key);
+  return _LLCacheAdmitted(cache, LLPushKeyedInteger(cache->list, key, value, type));
+}
+
+LinkNode *LLCachePutDecimal(LLCache *cache, LLKey key, MAX_DEC_TYPE value, LLDecimalType type)
+{
+  _LLCacheAdmit(cache, key);
+  return _LLCacheAdmitted(cache, LLPushKeyedDecimal(cache->list, key, value, type));
+}
+
+LinkNode *LLCachePutString(LLCache *cache, LLKey key, LLVoid string, LLStringType type)
+{
+  _LLCacheAdmit(cache, key);
+  return _LLCacheAdmitted(cache, LLPushKeyedString(cache->list, key, string, type));
+}
+
+LinkNode *LLCachePutVoid(LLCache *cache, LLKey key, LLVoid data)
+{
+  _LLCacheAdmit(cache, key);
+  return _LLCacheAdmitted(cache, LLPushKeyedVoid(cache->list, key, data));
+}
@@ -0,0 +1,64 @@
+#ifndef LL_CACHE_H
+#define LL_CACHE_H
+
+#include "LinkList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/** Invoked with each node pushed out of a full cache, just before LNDelete */
+typedef void (*LLCacheEvictFn)(LinkNode *node, LLVoid context);
+
+typedef struct LLCacheStats
+{
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long evictions;
+} LLCacheStats;
+
+/** A bounded LRU cache. The list holds keyed nodes ordered from least to
+ * most recently used and carries a key index, so lookups, promotion to the
+ * tail and eviction from the head are all constant time. */
+typedef struct LLCache
+{
+  LinkList *list;
+  size_t capacity;
+  size_t count;
+
+  LLCacheEvictFn onEvict;
+  LLVoid context;
+
+  LLCacheStats stats;
+} LLCache;
+
+#pragma mark - Creation Functions
+
+LLCache *LLCacheCreate(size_t capacity, LLCacheEvictFn onEvict, LLVoid context);
+
+#pragma mark - Deallocation Functions
+
+void LLCacheDelete(LLCache *cache);
+
+#pragma mark - Lookup Functions
+
+LinkNode *LLCacheGet(LLCache *cache, LLKey key);
+LinkNode *LLCachePeek(LLCache *cache, LLKey key);
+LLBoolean LLCacheRemove(LLCache *cache, LLKey key);
+void LLCacheGetStats(LLCache *cache, LLCacheStats *stats);
+
+#pragma mark - Insertion Functions
+
+LinkNode *LLCachePutBoolean(LLCache *cache, LLKey key, LLBoolean boolean);
+LinkNode *LLCachePutInteger(LLCache *cache, LLKey key, MAX_INT_TYPE value, LLIntegerType type);
+LinkNode *LLCachePutDecimal(LLCache *cache, LLKey key, MAX_DEC_TYPE value, LLDecimalType type);
+LinkNode *LLCachePutString(LLCache *cache, LLKey key, LLVoid string, LLStringType type);
+LinkNode *LLCachePutVoid(LLCache *cache, LLKey key, LLVoid data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
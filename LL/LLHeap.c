@@ -0,0 +1,244 @@
+#include "LLHeap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* A 4-ary layout halves the depth of a binary heap and keeps each set of
+ * siblings on one or two cache lines, which is where pop-min spends time. */
+#define LL_HEAP_ARITY 4
+
+#pragma mark - Internal Helper Functions
+
+MAX_DEC_TYPE _LLHeapNumber(LinkNode *node)
+{
+  return node->type == LN_DECIMAL
+    ? LLDecimalValue((LLDecimalNode *)node->value)
+    : (MAX_DEC_TYPE)LLIntegerValue((LLIntegerNode *)node->value);
+}
+
+void _LLHeapPlace(LLHeap *heap, LLHeapNode *node, size_t position)
+{
+  heap->nodes[position] = node;
+  node->position = position;
+}
+
+void _LLHeapSiftUp(LLHeap *heap, size_t position)
+{
+  LLHeapNode *node = heap->nodes[position];
+  size_t parent;
+
+  while (position > 0)
+  {
+    parent = (position - 1) / LL_HEAP_ARITY;
+    if (heap->compare(&node->link, &heap->nodes[parent]->link) >= 0) break;
+
+    _LLHeapPlace(heap, heap->nodes[parent], position);
+    position = parent;
+  }
+
+  _LLHeapPlace(heap, node, position);
+}
+
+void _LLHeapSiftDown(LLHeap *heap, size_t position)
+{
+  LLHeapNode *node = heap->nodes[position];
+  size_t child, best, last;
+
+  for (;;)
+  {
+    child = position * LL_HEAP_ARITY + 1;
+    if (child >= heap->count) break;
+
+    last = child + LL_HEAP_ARITY < heap->count ? child + LL_HEAP_ARITY : heap->count;
+    for (best = child++; child < last; child++)
+    {
+      if (heap->compare(&heap->nodes[child]->link, &heap->nodes[best]->link) < 0)
+      {
+        best = child;
+      }
+    }
+
+    if (heap->compare(&heap->nodes[best]->link, &node->link) >= 0) break;
+
+    _LLHeapPlace(heap, heap->nodes[best], position);
+    position = best;
+  }
+
+  _LLHeapPlace(heap, node, position);
+}
+
+LLHeapNode *_LLHeapInsert(LLHeap *heap, LLVoid value, LinkNodeDataType type)
+{
+  LLHeapNode *node;
+  LLHeapNode **nodes;
+  size_t capacity;
+
+  if (!value) return NULL;
+
+  if (heap->count == heap->capacity)
+  {
+    capacity = heap->capacity ? heap->capacity * 2 : 64;
+    nodes = (LLHeapNode **)realloc(heap->nodes, capacity * sizeof(LLHeapNode *));
+    if (!nodes)
+    {
+      free(value);
+      return NULL;
+    }
+    heap->nodes = nodes;
+    heap->capacity = capacity;
+  }
+
+  node = (LLHeapNode *)malloc(sizeof(LLHeapNode));
+  if (!node)
+  {
+    free(value);
+    return NULL;
+  }
+
+  LNInit(&node->link, No);
+  node->link.value = value;
+  node->link.type = type;
+
+  heap->nodes[heap->count] = node;
+  _LLHeapSiftUp(heap, heap->count++);
+  return node;
+}
+
+#pragma mark - Comparators
+
+int LLHeapCompareInteger(LinkNode *a, LinkNode *b)
+{
+  LLIntegerNode *left = (LLIntegerNode *)a->value;
+  LLIntegerNode *right = (LLIntegerNode *)b->value;
+  MAX_INT_TYPE l = LLIntegerValue(left), r = LLIntegerValue(right);
+
+  /* Two unsigned values may exceed the signed range, so compare them as such */
+  if (left->type & right->type & LLIN_UNSIGNED)
+  {
+    return (unsigned MAX_INT_TYPE)l < (unsigned MAX_INT_TYPE)r
+      ? -1 : (unsigned MAX_INT_TYPE)l > (unsigned MAX_INT_TYPE)r;
+  }
+
+  return l < r ? -1 : l > r;
+}
+
+int LLHeapCompareDecimal(LinkNode *a, LinkNode *b)
+{
+  MAX_DEC_TYPE l = LLDecimalValue((LLDecimalNode *)a->value);
+  MAX_DEC_TYPE r = LLDecimalValue((LLDecimalNode *)b->value);
+
+  return l < r ? -1 : l > r;
+}
+
+int LLHeapCompareNumeric(LinkNode *a, LinkNode *b)
+{
+  MAX_DEC_TYPE l, r;
+
+  if (a->type == LN_INTEGER && b->type == LN_INTEGER)
+  {
+    return LLHeapCompareInteger(a, b);
+  }
+
+  l = _LLHeapNumber(a);
+  r = _LLHeapNumber(b);
+  return l < r ? -1 : l > r;
+}
+
+#pragma mark - Creation Functions
+
+LLHeap *LLHeapCreate(LLHeapCompareFn compare)
+{
+  LLHeap *heap = (LLHeap *)malloc(sizeof(LLHeap));
+
+  if (!heap) return NULL;
+
+  memset(heap, 0L, sizeof(LLHeap));
+  heap->compare = compare ? compare : LLHeapCompareNumeric;
+  return heap;
+}
+
+#pragma mark - Deallocation Functions
+
+void LLHeapDelete(LLHeap *heap)
+{
+  size_t i;
+
+  if (!heap) return;
+
+  for (i = 0; i < heap->count; i++) LNDelete(&heap->nodes[i]->link);
+
+  free(heap->nodes);
+  free(heap);
+}
+
+#pragma mark - Heap Push Functions
+
+LLHeapNode *LLHeapPushInteger(LLHeap *heap, MAX_INT_TYPE value, LLIntegerType type)
+{
+  return _LLHeapInsert(heap, LNICreate(value, type), LN_INTEGER);
+}
+
+LLHeapNode *LLHeapPushDecimal(LLHeap *heap, MAX_DEC_TYPE value, LLDecimalType type)
+{
+  return _LLHeapInsert(heap, LNDCreate(value, type), LN_DECIMAL);
+}
+
+#pragma mark - Heap Pop Functions
+
+LLHeapNode *LLHeapPeek(LLHeap *heap)
+{
+  return heap && heap->count ? heap->nodes[0] : NULL;
+}
+
+LLHeapNode *LLHeapPop(LLHeap *heap)
+{
+  LLHeapNode *node = LLHeapPeek(heap);
+
+  if (node) LLHeapRemove(heap, node);
+  return node;
+}
+
+LLBoolean LLHeapRemove(LLHeap *heap, LLHeapNode *node)
+{
+  size_t position = node->position;
+  LLHeapNode *last;
+
+  if (position >= heap->count || heap->nodes[position] != node) return No;
+
+  last = heap->nodes[--heap->count];
+  if (last != node)
+  {
+    _LLHeapPlace(heap, last, position);
+    LLHeapUpdate(heap, last);
+  }
+
+  node->position = (size_t)-1;
+  return Yes;
+}
+
+#pragma mark - Heap Key Functions
+
+void LLHeapDecreaseInteger(LLHeap *heap, LLHeapNode *node, MAX_INT_TYPE value)
+{
+  LLIntegerNode *data = (LLIntegerNode *)node->link.value;
+
+  LNSetIntByType(data, data->type, value);
+  LLHeapUpdate(heap, node);
+}
+
+void LLHeapDecreaseDecimal(LLHeap *heap, LLHeapNode *node, MAX_DEC_TYPE value)
+{
+  LLDecimalNode *data = (LLDecimalNode *)node->link.value;
+
+  LNSetDecByType(data, data->type, value);
+  LLHeapUpdate(heap, node);
+}
+
+void LLHeapUpdate(LLHeap *heap, LLHeapNode *node)
+{
+  size_t position = node->position;
+
+  /* The value may have moved either way; at most one of these does work */
+  _LLHeapSiftUp(heap, position);
+  if (heap->nodes[position] == node) _LLHeapSiftDown(heap, position);
+}
@@ -0,0 +1,71 @@
+#ifndef LL_HEAP_H
+#define LL_HEAP_H
+
+#include "LinkList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/** Orders two heap nodes; negative when a should be popped before b */
+typedef int (*LLHeapCompareFn)(LinkNode *a, LinkNode *b);
+
+/** Handle to a queued value. The LinkNode comes first so a handle popped
+ * from the heap can be released with LNDelete(&handle->link). Its value is
+ * an LLIntegerNode or LLDecimalNode just as on a LinkList. */
+typedef struct LLHeapNode
+{
+  LinkNode link;
+  size_t position;
+} LLHeapNode;
+
+/** Array backed 4-ary min heap of numeric nodes */
+typedef struct LLHeap
+{
+  LLHeapNode **nodes;
+  size_t count;
+  size_t capacity;
+  LLHeapCompareFn compare;
+} LLHeap;
+
+#pragma mark - Comparators
+
+int LLHeapCompareInteger(LinkNode *a, LinkNode *b);
+int LLHeapCompareDecimal(LinkNode *a, LinkNode *b);
+int LLHeapCompareNumeric(LinkNode *a, LinkNode *b);
+
+#pragma mark - Creation Functions
+
+LLHeap *LLHeapCreate(LLHeapCompareFn compare);
+
+#pragma mark - Deallocation Functions
+
+void LLHeapDelete(LLHeap *heap);
+
+#pragma mark - Heap Push Functions
+
+LLHeapNode *LLHeapPushInteger(LLHeap *heap, MAX_INT_TYPE value, LLIntegerType type);
+LLHeapNode *LLHeapPushDecimal(LLHeap *heap, MAX_DEC_TYPE value, LLDecimalType type);
+
+#pragma mark - Heap Pop Functions
+
+LLHeapNode *LLHeapPeek(LLHeap *heap);
+LLHeapNode *LLHeapPop(LLHeap *heap);
+LLBoolean LLHeapRemove(LLHeap *heap, LLHeapNode *node);
+
+#pragma mark - Heap Key Functions
+
+/* Set a node's value and restore its place. The decrease is only the
+ * usual case: a value moving the other way, or a comparator ordering the
+ * heap largest first, sifts the node down instead. */
+void LLHeapDecreaseInteger(LLHeap *heap, LLHeapNode *node, MAX_INT_TYPE value);
+void LLHeapDecreaseDecimal(LLHeap *heap, LLHeapNode *node, MAX_DEC_TYPE value);
+void LLHeapUpdate(LLHeap *heap, LLHeapNode *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,434 @@
+#include "LLImage.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(LL_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define LL_IMAGE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define LL_IMAGE_ALIGN 16
+#define LL_IMAGE_BYTE_ORDER 0x01020304
+
+/* Shared with LinkList.c, so images hash and fold keys as lists do */
+unsigned long _LLKeyHashLength(LLKey key, size_t *length);
+LLBoolean _LLKeyFoldEquals(const char *a, const char *b, size_t length);
+
+#pragma mark - Internal Helper Functions
+
+size_t _LLImageAlign(size_t offset, size_t alignment)
+{
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+LLBoolean _LLImagePad(FILE *file, size_t from, size_t to)
+{
+  static const char zeros[LL_IMAGE_ALIGN] = { 0 };
+  size_t chunk;
+
+  while (from < to)
+  {
+    chunk = to - from < LL_IMAGE_ALIGN ? to - from : LL_IMAGE_ALIGN;
+    if (fwrite(zeros, 1, chunk, file) != chunk) return No;
+    from += chunk;
+  }
+
+  return Yes;
+}
+
+LLBoolean _LLImageStorable(LinkNode *node)
+{
+  int unkeyedType = node->type & LN_TYPE_MASK;
+
+  return node->value && unkeyedType != LN_USER && unkeyedType != LN_VOID ? Yes : No;
+}
+
+LLStringNode *_LLImageStringNode(LinkNode *node)
+{
+  if ((node->type & LN_TYPE_MASK) != LN_STRING) return NULL;
+
+  return node->type & LN_KEYED
+    ? &((LLKeyedString *)node->value)->string
+    : (LLStringNode *)node->value;
+}
+
+/* Bytes a string value occupies in the data area, terminator included */
+size_t _LLImageStringSize(LLStringNode *string)
+{
+  #ifdef WCHAR_SUPPORT
+  if (string->type == LLSN_WIDE) return (wcslen(string->u.w) + 1) * sizeof(wchar_t);
+  #endif
+  return strlen(string->u.s) + 1;
+}
+
+size_t _LLImageStringAlign(LLStringNode *string)
+{
+  #ifdef WCHAR_SUPPORT
+  if (string->type == LLSN_WIDE) return sizeof(wchar_t);
+  #else
+  (void)string;
+  #endif
+  return 1;
+}
+
+/* Narrow and wide strings alike end within the zero unit closing the data */
+LLBoolean _LLImageOffsetValid(LLImage *image, size_t offset)
+{
+  return offset >= image->header->dataOffset && offset < image->header->size ? Yes : No;
+}
+
+void _LLImageRecord(LinkNode *node, LLImageNode *record)
+{
+  LLBoolean isKeyed = node->type & LN_KEYED ? Yes : No;
+  LLIntegerNode *intNode;
+  LLDecimalNode *decNode;
+  LLStringNode *strNode;
+
+  record->type = node->type & (LN_TYPE_MASK | LN_KEYED | LN_INT_KEYED);
+  if (isKeyed)
+  {
+    record->keyHash = ((LLKeyedNode *)node->value)->keyHash;
+    record->keyLength = ((LLKeyedNode *)node->value)->keyLength;
+  }
+  if (node->type & LN_INT_KEYED) record->intKey = ((LLIntKeyed *)node->value)->key;
+
+  switch (node->type & LN_TYPE_MASK)
+  {
+    case LN_BOOLEAN:
+      record->u.b = isKeyed
+        ? ((LLKeyedBool *)node->value)->boolean
+        : ((LLBoolNode *)node->value)->boolean;
+      break;
+
+    case LN_INTEGER:
+      intNode = isKeyed ? &((LLKeyedInteger *)node->value)->integer : (LLIntegerNode *)node->value;
+      record->subtype = intNode->type;
+      record->u.i = LLIntegerValue(intNode);
+      break;
+
+    case LN_DECIMAL:
+      decNode = isKeyed ? &((LLKeyedDecimal *)node->value)->decimal : (LLDecimalNode *)node->value;
+      record->subtype = decNode->type;
+      record->u.d = LLDecimalValue(decNode);
+      break;
+
+    case LN_STRING:
+      strNode = _LLImageStringNode(node);
+      record->subtype = strNode->type;
+      break;
+  }
+}
+
+LLBoolean _LLImageValid(unsigned char *base, size_t size)
+{
+  LLImageHeader *header = (LLImageHeader *)base;
+  size_t i;
+
+  if (size < sizeof(LLImageHeader)) return No;
+  if (memcmp(header->magic, "LLI", 3) != 0 || header->version != LL_IMAGE_VERSION) return No;
+  if (header->wordSize != sizeof(size_t) || header->byteOrder != LL_IMAGE_BYTE_ORDER) return No;
+
+  /* Regions lie in order inside the file; checked by division, so that
+   * no corrupt count can overflow its way past */
+  if (header->size > size || header->size % sizeof(wchar_t)) return No;
+  if (header->nodesOffset < sizeof(LLImageHeader) || header->nodesOffset % LL_IMAGE_ALIGN) return No;
+  if (header->bucketsOffset < header->nodesOffset || header->bucketsOffset % sizeof(size_t)) return No;
+  if (header->dataOffset < header->bucketsOffset || header->dataOffset > header->size) return No;
+  if (header->size - header->dataOffset < sizeof(wchar_t)) return No;
+  if (header->count > (header->bucketsOffset - header->nodesOffset) / sizeof(LLImageNode)) return No;
+  if (header->bucketCount == 0 || (header->bucketCount & (header->bucketCount - 1))) return No;
+  if (header->bucketCount > (header->dataOffset - header->bucketsOffset) / sizeof(size_t)) return No;
+
+  /* Records are checked as they are read; the closing zero unit is what
+   * lets an in-bounds string offset be trusted to end in bounds */
+  for (i = header->size - sizeof(wchar_t); i < header->size; i++) if (base[i]) return No;
+
+  return Yes;
+}
+
+#pragma mark - Image File Functions
+
+LLBoolean LLImageWrite(LinkList *list, const char *path)
+{
+  FILE *file = NULL;
+  char *tmp = (char *)malloc(strlen(path) + sizeof(".tmp"));
+  LLImageHeader header;
+  LLImageNode record;
+  LLStringNode *string;
+  LinkNode *node;
+  size_t *buckets = NULL, *next = NULL;
+  size_t count = 0, bucketCount = 8, i, cursor, length, bucket;
+  LLBoolean ok = No;
+
+  for (node = list->head; node; node = node->next) if (_LLImageStorable(node)) count++;
+  while (bucketCount < count) bucketCount <<= 1;
+
+  buckets = (size_t *)calloc(bucketCount, sizeof(size_t));
+  next = (size_t *)calloc(count ? count : 1, sizeof(size_t));
+  if (!buckets || !next || !tmp) goto done;
+
+  /* Mappers of the old image keep it until the finished one is renamed
+   * over it; rewriting in place would pull pages out from under them */
+  strcpy(tmp, path);
+  strcat(tmp, ".tmp");
+  if (!(file = fopen(tmp, "wb"))) goto done;
+
+  /* Chains are built back to front so each lists its nodes in list order */
+  for (node = list->tail, i = count; node; node = node->prev)
+  {
+    if (!_LLImageStorable(node)) continue;
+    i--;
+    if (!(node->type & LN_KEYED)) continue;
+
+    bucket = ((LLKeyedNode *)node->value)->keyHash & (bucketCount - 1);
+    next[i] = buckets[bucket];
+    buckets[bucket] = i + 1;
+  }
+
+  memset(&header, 0L, sizeof(LLImageHeader));
+  memcpy(header.magic, "LLI1", 4);
+  header.version = LL_IMAGE_VERSION;
+  header.wordSize = sizeof(size_t);
+  header.byteOrder = LL_IMAGE_BYTE_ORDER;
+  header.flags = list->caseSensitiveKeys ? LL_IMAGE_CASE_SENSITIVE : 0;
+  header.count = count;
+  header.bucketCount = bucketCount;
+  header.nodesOffset = _LLImageAlign(sizeof(LLImageHeader), LL_IMAGE_ALIGN);
+  header.bucketsOffset = header.nodesOffset + count * sizeof(LLImageNode);
+  header.dataOffset = _LLImageAlign(header.bucketsOffset + bucketCount * sizeof(size_t), LL_IMAGE_ALIGN);
+
+  if (fwrite(&header, sizeof(LLImageHeader), 1, file) != 1) goto done;
+  if (!_LLImagePad(file, sizeof(LLImageHeader), header.nodesOffset)) goto done;
+
+  /* Records: string placement is computed here and replayed below */
+  cursor = header.dataOffset;
+  for (node = list->head, i = 0; node; node = node->next)
+  {
+    if (!_LLImageStorable(node)) continue;
+
+    memset(&record, 0L, sizeof(LLImageNode));
+    _LLImageRecord(node, &record);
+    record.nextInBucket = next[i++];
+
+    if (node->type & LN_KEYED)
+    {
+      record.keyOffset = cursor;
+      cursor += strlen(((LLKeyedNode *)node->value)->key) + 1;
+    }
+    if ((string = _LLImageStringNode(node)) != NULL)
+    {
+      cursor = _LLImageAlign(cursor, _LLImageStringAlign(string));
+      record.valueOffset = cursor;
+      cursor += _LLImageStringSize(string);
+    }
+
+    if (fwrite(&record, sizeof(LLImageNode), 1, file) != 1) goto done;
+  }
+
+  if (fwrite(buckets, sizeof(size_t), bucketCount, file) != bucketCount) goto done;
+  if (!_LLImagePad(file, header.bucketsOffset + bucketCount * sizeof(size_t), header.dataOffset)) goto done;
+
+  cursor = header.dataOffset;
+  for (node = list->head; node; node = node->next)
+  {
+    if (!_LLImageStorable(node)) continue;
+
+    if (node->type & LN_KEYED)
+    {
+      length = strlen(((LLKeyedNode *)node->value)->key) + 1;
+      if (fwrite(((LLKeyedNode *)node->value)->key, 1, length, file) != length) goto done;
+      cursor += length;
+    }
+    if ((string = _LLImageStringNode(node)) != NULL)
+    {
+      length = _LLImageAlign(cursor, _LLImageStringAlign(string));
+      if (!_LLImagePad(file, cursor, length)) goto done;
+      cursor = length;
+
+      length = _LLImageStringSize(string);
+      if (fwrite(string->u.s, 1, length, file) != length) goto done;
+      cursor += length;
+    }
+  }
+
+  length = _LLImageAlign(cursor, sizeof(wchar_t)) + sizeof(wchar_t);
+  if (!_LLImagePad(file, cursor, length)) goto done;
+  cursor = length;
+
+  header.size = cursor;
+  if (fseek(file, 0L, SEEK_SET) != 0) goto done;
+  if (fwrite(&header, sizeof(LLImageHeader), 1, file) != 1) goto done;
+  if (fflush(file) != 0) goto done;
+  #ifdef LL_IMAGE_MMAP
+  if (fsync(fileno(file)) != 0) goto done;
+  #endif
+  ok = Yes;
+
+done:
+  if (file && fclose(file) != 0) ok = No;
+  if (ok && rename(tmp, path) != 0) ok = No;
+  if (!ok && file) remove(tmp);
+  free(tmp);
+  free(buckets);
+  free(next);
+  return ok;
+}
+
+LLImage *LLImageOpen(const char *path)
+{
+  LLImage *image = (LLImage *)malloc(sizeof(LLImage));
+  #ifdef LL_IMAGE_MMAP
+  struct stat info;
+  void *mapping;
+  int fd;
+  #else
+  FILE *file;
+  long size;
+  #endif
+
+  if (!image) return NULL;
+  memset(image, 0L, sizeof(LLImage));
+
+  #ifdef LL_IMAGE_MMAP
+  /* Pages fault in on first touch and are shared with other mappers */
+  fd = open(path, O_RDONLY);
+  if (fd < 0) goto fail;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0)
+  {
+    close(fd);
+    goto fail;
+  }
+
+  mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) goto fail;
+
+  image->base = (unsigned char *)mapping;
+  image->size = (size_t)info.st_size;
+  image->mapped = Yes;
+  #else
+  file = fopen(path, "rb");
+  if (!file) goto fail;
+  if (fseek(file, 0L, SEEK_END) != 0 || (size = ftell(file)) <= 0 || fseek(file, 0L, SEEK_SET) != 0)
+  {
+    fclose(file);
+    goto fail;
+  }
+
+  image->base = (unsigned char *)malloc((size_t)size);
+  image->size = (size_t)size;
+  if (!image->base || fread(image->base, 1, image->size, file) != image->size)
+  {
+    fclose(file);
+    goto fail;
+  }
+  fclose(file);
+  #endif
+
+  if (!_LLImageValid(image->base, image->size)) goto fail;
+
+  image->header = (LLImageHeader *)image->base;
+  image->nodes = (LLImageNode *)(image->base + image->header->nodesOffset);
+  image->buckets = (size_t *)(image->base + image->header->bucketsOffset);
+  return image;
+
+fail:
+  LLImageClose(image);
+  return NULL;
+}
+
+void LLImageClose(LLImage *image)
+{
+  if (!image) return;
+
+  #ifdef LL_IMAGE_MMAP
+  if (image->mapped) munmap(image->base, image->size);
+  #endif
+  if (!image->mapped) free(image->base);
+
+  free(image);
+}
+
+#pragma mark - Image Query Functions
+
+size_t LLImageCount(LLImage *image)
+{
+  return image->header->count;
+}
+
+LLImageNode *LLImageAt(LLImage *image, size_t index)
+{
+  return index < image->header->count ? &image->nodes[index] : NULL;
+}
+
+LLImageNode *LLImageFind(LLImage *image, LLKey key)
+{
+  size_t length;
+  unsigned long hash = _LLKeyHashLength(key, &length);
+  size_t index = image->buckets[hash & (image->header->bucketCount - 1)];
+  size_t steps = image->header->count;
+  LLBoolean exact = image->header->flags & LL_IMAGE_CASE_SENSITIVE ? Yes : No;
+  const char *stored;
+  LLImageNode *node;
+
+  /* A chain can visit each record at most once, however corrupt */
+  while (index && index <= image->header->count && steps--)
+  {
+    node = &image->nodes[index - 1];
+    if (node->keyHash == hash && node->keyLength == length && _LLImageOffsetValid(image, node->keyOffset)
+      && image->header->size - node->keyOffset > length)
+    {
+      stored = (const char *)image->base + node->keyOffset;
+      if (exact ? memcmp(stored, key, length) == 0 : _LLKeyFoldEquals(stored, key, length)) return node;
+    }
+    index = node->nextInBucket;
+  }
+
+  return NULL;
+}
+
+#pragma mark - Image Accessor Functions
+
+const char *LLImageKey(LLImage *image, LLImageNode *node)
+{
+  if (!(node->type & LN_KEYED) || !_LLImageOffsetValid(image, node->keyOffset)) return NULL;
+  return (const char *)image->base + node->keyOffset;
+}
+
+const char *LLImageString(LLImage *image, LLImageNode *node)
+{
+  if ((node->type & LN_TYPE_MASK) != LN_STRING || !_LLImageOffsetValid(image, node->valueOffset)) return NULL;
+  return (const char *)image->base + node->valueOffset;
+}
+
+MAX_INT_TYPE LLImageInteger(LLImageNode *node)
+{
+  return node->u.i;
+}
+
+MAX_DEC_TYPE LLImageDecimal(LLImageNode *node)
+{
+  return node->u.d;
+}
+
+LLBoolean LLImageBoolean(LLImageNode *node)
+{
+  return node->u.b;
+}
+
+LLIntKey LLImageIntKey(LLImageNode *node)
+{
+  return node->intKey;
+}
+
+#ifdef WCHAR_SUPPORT
+const wchar_t *LLImageWString(LLImage *image, LLImageNode *node)
+{
+  if (node->valueOffset % sizeof(wchar_t)) return NULL;
+  return (const wchar_t *)LLImageString(image, node);
+}
+#endif
@@ -0,0 +1,101 @@
+#ifndef LL_IMAGE_H
+#define LL_IMAGE_H
+
+#include "LinkList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A list image is a read-only snapshot laid out so it can be mapped and
+ * queried without being rebuilt:
+ *
+ *   LLImageHeader
+ *   LLImageNode[count]      fixed size records, in list order
+ *   size_t[bucketCount]     key hash buckets, node index + 1 or 0
+ *   string data             keys and string values, NUL terminated
+ *
+ * Every reference is a byte offset from the start of the image, so the
+ * pages can be shared by any number of processes mapping the same file.
+ * Images use native word size and byte order and are rejected elsewhere.
+ * Keys match as they did in the list written: exactly, or ignoring ASCII
+ * case, as recorded by LL_IMAGE_CASE_SENSITIVE in the header flags. */
+#define LL_IMAGE_VERSION 3
+#define LL_IMAGE_CASE_SENSITIVE 1
+
+#pragma mark - Types
+
+typedef struct LLImageHeader
+{
+  char magic[4];
+  unsigned int version;
+  unsigned int wordSize;
+  unsigned int byteOrder;
+  unsigned int flags;
+  size_t count;
+  size_t bucketCount;
+  size_t nodesOffset;
+  size_t bucketsOffset;
+  size_t dataOffset;
+  size_t size;
+} LLImageHeader;
+
+typedef struct LLImageNode
+{
+  size_t keyOffset;
+  size_t valueOffset;
+  size_t nextInBucket;
+  unsigned long keyHash;
+  unsigned int keyLength;
+  unsigned int type;
+  unsigned int subtype;
+
+  /* Key of an LN_INT_KEYED record, 0 for any other */
+  LLIntKey intKey;
+  union
+  {
+    MAX_INT_TYPE i;
+    MAX_DEC_TYPE d;
+    LLBoolean b;
+  } u;
+} LLImageNode;
+
+typedef struct LLImage
+{
+  unsigned char *base;
+  size_t size;
+  LLImageHeader *header;
+  LLImageNode *nodes;
+  size_t *buckets;
+  LLBoolean mapped;
+} LLImage;
+
+#pragma mark - Image File Functions
+
+LLBoolean LLImageWrite(LinkList *list, const char *path);
+LLImage *LLImageOpen(const char *path);
+void LLImageClose(LLImage *image);
+
+#pragma mark - Image Query Functions
+
+size_t LLImageCount(LLImage *image);
+LLImageNode *LLImageAt(LLImage *image, size_t index);
+LLImageNode *LLImageFind(LLImage *image, LLKey key);
+
+#pragma mark - Image Accessor Functions
+
+const char *LLImageKey(LLImage *image, LLImageNode *node);
+const char *LLImageString(LLImage *image, LLImageNode *node);
+MAX_INT_TYPE LLImageInteger(LLImageNode *node);
+MAX_DEC_TYPE LLImageDecimal(LLImageNode *node);
+LLBoolean LLImageBoolean(LLImageNode *node);
+LLIntKey LLImageIntKey(LLImageNode *node);
+#ifdef WCHAR_SUPPORT
+const wchar_t *LLImageWString(LLImage *image, LLImageNode *node);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
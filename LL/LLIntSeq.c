@@ -0,0 +1,343 @@
+#include "LLIntSeq.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LL_INTSEQ_SIGN (sizeof(MAX_INT_TYPE) * 8 - 1)
+
+#pragma mark - Internal Helper Functions
+
+/* Deltas are taken in unsigned arithmetic, so any pair of values wraps
+ * cleanly; zigzag then keeps small negative steps small */
+unsigned MAX_INT_TYPE _LLIntSeqZigzag(unsigned MAX_INT_TYPE delta)
+{
+  return (delta << 1) ^ (0 - (delta >> LL_INTSEQ_SIGN));
+}
+
+unsigned MAX_INT_TYPE _LLIntSeqUnzigzag(unsigned MAX_INT_TYPE zigzag)
+{
+  return (zigzag >> 1) ^ (0 - (zigzag & 1));
+}
+
+unsigned MAX_INT_TYPE _LLIntSeqVarint(const unsigned char *bytes, size_t *offset)
+{
+  unsigned MAX_INT_TYPE value;
+  size_t position = *offset;
+  int shift = 7;
+
+  /* One byte deltas are the common case for dense runs */
+  if (bytes[position] < 0x80)
+  {
+    *offset = position + 1;
+    return bytes[position];
+  }
+
+  value = bytes[position] & 0x7f;
+  while (bytes[position++] & 0x80)
+  {
+    value |= (unsigned MAX_INT_TYPE)(bytes[position] & 0x7f) << shift;
+    shift += 7;
+  }
+
+  *offset = position;
+  return value;
+}
+
+LLBoolean _LLIntSeqReserve(LLIntSeq *seq, size_t bytes)
+{
+  size_t capacity = seq->capacity ? seq->capacity : 256;
+  unsigned char *grown;
+
+  if (seq->used + bytes <= seq->capacity) return Yes;
+  while (capacity < seq->used + bytes) capacity <<= 1;
+
+  grown = (unsigned char *)realloc(seq->bytes, capacity);
+  if (!grown) return No;
+
+  seq->bytes = grown;
+  seq->capacity = capacity;
+  return Yes;
+}
+
+LLBoolean _LLIntSeqAddBlock(LLIntSeq *seq, MAX_INT_TYPE first)
+{
+  size_t capacity = seq->blockCapacity ? seq->blockCapacity << 1 : 16;
+  LLIntSeqBlock *grown;
+
+  if (seq->blockCount == seq->blockCapacity)
+  {
+    grown = (LLIntSeqBlock *)realloc(seq->blocks, capacity * sizeof(LLIntSeqBlock));
+    if (!grown) return No;
+
+    seq->blocks = grown;
+    seq->blockCapacity = capacity;
+  }
+
+  seq->blocks[seq->blockCount].first = first;
+  seq->blocks[seq->blockCount].offset = seq->used;
+  seq->blockCount++;
+  return Yes;
+}
+
+/* Read blocks must hold exactly their deltas, each varint ending inside */
+LLBoolean _LLIntSeqValidBlock(const unsigned char *bytes, size_t length, size_t deltas)
+{
+  size_t offset = 0, width;
+
+  while (deltas--)
+  {
+    for (width = 1; offset < length && bytes[offset] & 0x80; offset++, width++)
+    {
+      if (width == (sizeof(MAX_INT_TYPE) * 8 + 6) / 7) return No;
+    }
+    if (offset++ >= length) return No;
+  }
+
+  return offset == length ? Yes : No;
+}
+
+#pragma mark - Creation Functions
+
+LLIntSeq *LLIntSeqCreate(LLIntegerType type)
+{
+  LLIntSeq *seq = (LLIntSeq *)malloc(sizeof(LLIntSeq));
+
+  if (!seq) return NULL;
+  memset(seq, 0L, sizeof(LLIntSeq));
+  seq->type = type;
+  return seq;
+}
+
+LLIntSeq *LLIntSeqFromList(LinkList *list, LLIntegerType type)
+{
+  LLIntSeq *seq = LLIntSeqCreate(type);
+  LinkNode *node;
+
+  if (!seq) return NULL;
+
+  for (node = list->head; node; node = node->next)
+  {
+    if ((node->type & LN_TYPE_MASK) != LN_INTEGER || !node->value) continue;
+
+    if (!LLIntSeqAppend(seq, LLIntegerValue(node->type & LN_KEYED
+      ? &((LLKeyedInteger *)node->value)->integer
+      : (LLIntegerNode *)node->value)))
+    {
+      LLIntSeqDelete(seq);
+      return NULL;
+    }
+  }
+
+  return seq;
+}
+
+#pragma mark - Deallocation Functions
+
+void LLIntSeqDelete(LLIntSeq *seq)
+{
+  if (!seq) return;
+
+  free(seq->bytes);
+  free(seq->blocks);
+  free(seq);
+}
+
+#pragma mark - Sequence Functions
+
+LLBoolean LLIntSeqAppend(LLIntSeq *seq, MAX_INT_TYPE value)
+{
+  unsigned MAX_INT_TYPE zigzag;
+
+  if (seq->count % LL_INTSEQ_BLOCK == 0)
+  {
+    if (!_LLIntSeqAddBlock(seq, value)) return No;
+  }
+  else
+  {
+    zigzag = _LLIntSeqZigzag((unsigned MAX_INT_TYPE)value - (unsigned MAX_INT_TYPE)seq->last);
+    if (!_LLIntSeqReserve(seq, (sizeof(zigzag) * 8 + 6) / 7)) return No;
+
+    while (zigzag >= 0x80)
+    {
+      seq->bytes[seq->used++] = (unsigned char)(zigzag | 0x80);
+      zigzag >>= 7;
+    }
+    seq->bytes[seq->used++] = (unsigned char)zigzag;
+  }
+
+  seq->last = value;
+  seq->count++;
+  return Yes;
+}
+
+size_t LLIntSeqCount(LLIntSeq *seq)
+{
+  return seq->count;
+}
+
+MAX_INT_TYPE LLIntSeqAt(LLIntSeq *seq, size_t index)
+{
+  LLIntSeqCursor cursor;
+  MAX_INT_TYPE value = 0;
+
+  LLIntSeqCursorInit(&cursor, seq, index);
+  LLIntSeqNext(&cursor, &value);
+  return value;
+}
+
+size_t LLIntSeqFootprint(LLIntSeq *seq)
+{
+  return sizeof(LLIntSeq) + seq->capacity + seq->blockCapacity * sizeof(LLIntSeqBlock);
+}
+
+#pragma mark - Decoding Functions
+
+void LLIntSeqCursorInit(LLIntSeqCursor *cursor, LLIntSeq *seq, size_t index)
+{
+  LLIntSeqBlock *block;
+  size_t skip;
+
+  cursor->seq = seq;
+  cursor->index = index < seq->count ? index : seq->count;
+  cursor->offset = 0;
+  cursor->value = 0;
+
+  /* Mid-block starts replay the block's deltas up to the value before */
+  skip = cursor->index % LL_INTSEQ_BLOCK;
+  if (!skip || cursor->index == seq->count) return;
+
+  block = &seq->blocks[cursor->index / LL_INTSEQ_BLOCK];
+  cursor->value = block->first;
+  cursor->offset = block->offset;
+  while (--skip)
+  {
+    cursor->value = (MAX_INT_TYPE)((unsigned MAX_INT_TYPE)cursor->value
+      + _LLIntSeqUnzigzag(_LLIntSeqVarint(seq->bytes, &cursor->offset)));
+  }
+}
+
+LLBoolean LLIntSeqNext(LLIntSeqCursor *cursor, MAX_INT_TYPE *value)
+{
+  LLIntSeq *seq = cursor->seq;
+  LLIntSeqBlock *block;
+
+  if (cursor->index >= seq->count) return No;
+
+  if (cursor->index % LL_INTSEQ_BLOCK == 0)
+  {
+    block = &seq->blocks[cursor->index / LL_INTSEQ_BLOCK];
+    cursor->value = block->first;
+    cursor->offset = block->offset;
+  }
+  else
+  {
+    cursor->value = (MAX_INT_TYPE)((unsigned MAX_INT_TYPE)cursor->value
+      + _LLIntSeqUnzigzag(_LLIntSeqVarint(seq->bytes, &cursor->offset)));
+  }
+
+  cursor->index++;
+  *value = cursor->value;
+  return Yes;
+}
+
+size_t LLIntSeqDecode(LLIntSeq *seq, size_t index, MAX_INT_TYPE *out, size_t max)
+{
+  const unsigned char *bytes = seq->bytes;
+  LLIntSeqCursor cursor;
+  unsigned MAX_INT_TYPE value;
+  size_t offset, end, i;
+
+  LLIntSeqCursorInit(&cursor, seq, index);
+  end = seq->count - cursor.index < max ? seq->count : cursor.index + max;
+  value = (unsigned MAX_INT_TYPE)cursor.value;
+  offset = cursor.offset;
+
+  /* The cursor loop with its state held in registers */
+  for (i = cursor.index; i < end; i++)
+  {
+    if (i % LL_INTSEQ_BLOCK == 0)
+    {
+      value = (unsigned MAX_INT_TYPE)seq->blocks[i / LL_INTSEQ_BLOCK].first;
+      offset = seq->blocks[i / LL_INTSEQ_BLOCK].offset;
+    }
+    else value += _LLIntSeqUnzigzag(_LLIntSeqVarint(bytes, &offset));
+
+    *out++ = (MAX_INT_TYPE)value;
+  }
+
+  return end - cursor.index;
+}
+
+#pragma mark - Conversion Functions
+
+size_t LLIntSeqToList(LLIntSeq *seq, LinkList *list)
+{
+  LLIntSeqCursor cursor;
+  MAX_INT_TYPE value;
+  size_t pushed = 0;
+
+  LLIntSeqCursorInit(&cursor, seq, 0);
+  while (LLIntSeqNext(&cursor, &value))
+  {
+    if (!LLPushInteger(list, value, seq->type)) break;
+    pushed++;
+  }
+
+  return pushed;
+}
+
+#pragma mark - Serialization Functions
+
+LLBoolean LLIntSeqWrite(LLWriter *writer, LLIntSeq *seq)
+{
+  size_t i, end;
+
+  LLWriteVarint(writer, (unsigned MAX_INT_TYPE)seq->count);
+  LLWriteVarint(writer, (unsigned MAX_INT_TYPE)seq->type);
+
+  for (i = 0; i < seq->blockCount && !writer->failed; i++)
+  {
+    end = i + 1 < seq->blockCount ? seq->blocks[i + 1].offset : seq->used;
+
+    LLWriteVarint(writer, _LLIntSeqZigzag((unsigned MAX_INT_TYPE)seq->blocks[i].first));
+    LLWriteVarint(writer, (unsigned MAX_INT_TYPE)(end - seq->blocks[i].offset));
+    LLWriteBytes(writer, seq->bytes + seq->blocks[i].offset, end - seq->blocks[i].offset);
+  }
+
+  return writer->failed ? No : Yes;
+}
+
+LLIntSeq *LLIntSeqRead(LLReader *reader)
+{
+  size_t count = (size_t)LLReadVarint(reader), blockCount, length, deltas, i;
+  LLIntegerType type = (LLIntegerType)LLReadVarint(reader);
+  LLIntSeq *seq;
+  MAX_INT_TYPE first;
+
+  if (reader->failed || !(seq = LLIntSeqCreate(type))) return NULL;
+
+  blockCount = (count + LL_INTSEQ_BLOCK - 1) / LL_INTSEQ_BLOCK;
+  for (i = 0; i < blockCount; i++)
+  {
+    first = (MAX_INT_TYPE)_LLIntSeqUnzigzag(LLReadVarint(reader));
+    length = (size_t)LLReadVarint(reader);
+
+    /* A block can hold no more than its deltas at full varint width */
+    if (reader->failed || length > LL_INTSEQ_BLOCK * ((sizeof(MAX_INT_TYPE) * 8 + 6) / 7)) goto fail;
+    if (!_LLIntSeqAddBlock(seq, first) || !_LLIntSeqReserve(seq, length)) goto fail;
+    if (!LLReadBytes(reader, seq->bytes + seq->used, length)) goto fail;
+
+    deltas = count - i * LL_INTSEQ_BLOCK;
+    deltas = (deltas < LL_INTSEQ_BLOCK ? deltas : LL_INTSEQ_BLOCK) - 1;
+    if (!_LLIntSeqValidBlock(seq->bytes + seq->used, length, deltas)) goto fail;
+    seq->used += length;
+  }
+
+  seq->count = count;
+  if (count) seq->last = LLIntSeqAt(seq, count - 1);
+  return seq;
+
+fail:
+  LLIntSeqDelete(seq);
+  return NULL;
+}
@@ -0,0 +1,94 @@
+#ifndef LL_INT_SEQ_H
+#define LL_INT_SEQ_H
+
+#include "LLSerialize.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A compact, append only run of integers. Values are grouped in blocks of
+ * LL_INTSEQ_BLOCK; each block records its first value and byte offset,
+ * and every later value in the block is stored as the zigzag varint of
+ * its delta from the one before. Monotonic timestamps a few ticks apart
+ * cost a byte or two each instead of a LinkNode plus an LLIntegerNode.
+ *
+ * Random access decodes at most one block; sequential access through an
+ * LLIntSeqCursor or LLIntSeqDecode never backtracks. */
+#ifndef LL_INTSEQ_BLOCK
+#define LL_INTSEQ_BLOCK 128
+#endif
+
+#pragma mark - Types
+
+typedef struct LLIntSeqBlock
+{
+  MAX_INT_TYPE first;
+  size_t offset;
+} LLIntSeqBlock;
+
+typedef struct LLIntSeq
+{
+  unsigned char *bytes;
+  size_t used;
+  size_t capacity;
+  LLIntSeqBlock *blocks;
+  size_t blockCount;
+  size_t blockCapacity;
+  size_t count;
+  MAX_INT_TYPE last;
+  LLIntegerType type;
+} LLIntSeq;
+
+typedef struct LLIntSeqCursor
+{
+  LLIntSeq *seq;
+  size_t index;
+  size_t offset;
+  MAX_INT_TYPE value;
+} LLIntSeqCursor;
+
+#pragma mark - Creation Functions
+
+/** type is what LLIntSeqToList gives the nodes it creates */
+LLIntSeq *LLIntSeqCreate(LLIntegerType type);
+LLIntSeq *LLIntSeqFromList(LinkList *list, LLIntegerType type);
+
+#pragma mark - Deallocation Functions
+
+void LLIntSeqDelete(LLIntSeq *seq);
+
+#pragma mark - Sequence Functions
+
+LLBoolean LLIntSeqAppend(LLIntSeq *seq, MAX_INT_TYPE value);
+size_t LLIntSeqCount(LLIntSeq *seq);
+MAX_INT_TYPE LLIntSeqAt(LLIntSeq *seq, size_t index);
+
+/** Heap bytes held by the sequence, including its block index */
+size_t LLIntSeqFootprint(LLIntSeq *seq);
+
+#pragma mark - Decoding Functions
+
+void LLIntSeqCursorInit(LLIntSeqCursor *cursor, LLIntSeq *seq, size_t index);
+LLBoolean LLIntSeqNext(LLIntSeqCursor *cursor, MAX_INT_TYPE *value);
+
+/** Decodes up to max values from index into out; returns how many */
+size_t LLIntSeqDecode(LLIntSeq *seq, size_t index, MAX_INT_TYPE *out, size_t max);
+
+#pragma mark - Conversion Functions
+
+/** Pushes every value as an integer node; returns the number pushed */
+size_t LLIntSeqToList(LLIntSeq *seq, LinkList *list);
+
+#pragma mark - Serialization Functions
+
+/* Written as varints: count, type, then per block its zigzag first value,
+ * byte length and delta bytes, which are copied through unchanged */
+LLBoolean LLIntSeqWrite(LLWriter *writer, LLIntSeq *seq);
+LLIntSeq *LLIntSeqRead(LLReader *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,580 @@
+#include "LLJournal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LL_JOURNAL_POSIX
+#include <fcntl.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#pragma mark - Internal Helper Functions
+
+char *_LLJournalPath(const char *path, const char *suffix)
+{
+  size_t length = strlen(path);
+  char *result = (char *)malloc(length + strlen(suffix) + 1);
+
+  if (!result) return NULL;
+  memcpy(result, path, length);
+  strcpy(result + length, suffix);
+  return result;
+}
+
+LLBoolean _LLJournalExists(const char *path)
+{
+  FILE *file = fopen(path, "rb");
+
+  if (!file) return No;
+  fclose(file);
+  return Yes;
+}
+
+unsigned long _LLJournalClock(void)
+{
+  #ifdef LL_JOURNAL_POSIX
+  struct timeval now;
+
+  gettimeofday(&now, NULL);
+  return (unsigned long)now.tv_sec * 1000UL + (unsigned long)now.tv_usec / 1000UL;
+  #else
+  return (unsigned long)time(NULL) * 1000UL;
+  #endif
+}
+
+LLBoolean _LLJournalFsync(FILE *file)
+{
+  if (fflush(file) != 0) return No;
+  #ifdef LL_JOURNAL_POSIX
+  if (fsync(fileno(file)) != 0) return No;
+  #endif
+  return Yes;
+}
+
+/* Makes renames and creations in path's directory durable */
+LLBoolean _LLJournalSyncDir(const char *path)
+{
+  #ifdef LL_JOURNAL_POSIX
+  const char *slash = strrchr(path, '/');
+  char *dir;
+  LLBoolean ok;
+  int fd;
+
+  if (!slash) dir = _LLJournalPath(".", "");
+  else if (slash == path) dir = _LLJournalPath("/", "");
+  else
+  {
+    dir = (char *)malloc((size_t)(slash - path) + 1);
+    if (dir)
+    {
+      memcpy(dir, path, (size_t)(slash - path));
+      dir[slash - path] = 0;
+    }
+  }
+  if (!dir) return No;
+
+  fd = open(dir, O_RDONLY);
+  free(dir);
+  if (fd < 0) return No;
+
+  ok = fsync(fd) == 0 ? Yes : No;
+  close(fd);
+  return ok;
+  #else
+  (void)path;
+  return Yes;
+  #endif
+}
+
+/* Writes list as the snapshot at lsn; the rename makes it all or nothing */
+LLBoolean _LLJournalSnapshot(LinkList *list, unsigned long lsn, const char *path, const char *tmp)
+{
+  FILE *file = fopen(tmp, "wb");
+  LLWriter writer;
+  LLBoolean ok;
+
+  if (!file) return No;
+
+  LLWriterInitFile(&writer, file);
+  LLWriteVarint(&writer, lsn);
+  LLWriteList(&writer, list);
+  ok = LLWriterFinish(&writer);
+  if (ok) ok = _LLJournalFsync(file);
+  if (fclose(file) != 0) ok = No;
+
+  if (ok && rename(tmp, path) == 0) return _LLJournalSyncDir(path);
+  remove(tmp);
+  return No;
+}
+
+/* Snapshots at lsn, after which the records in old are redundant */
+LLBoolean _LLJournalFold(LinkList *list, unsigned long lsn, const char *base)
+{
+  char *snap = _LLJournalPath(base, ".snap");
+  char *tmp = _LLJournalPath(base, ".snap.tmp");
+  char *old = _LLJournalPath(base, ".old");
+  LLBoolean ok = snap && tmp && old && _LLJournalSnapshot(list, lsn, snap, tmp);
+
+  if (ok) remove(old);
+
+  free(snap);
+  free(tmp);
+  free(old);
+  return ok;
+}
+
+LinkNode *_LLJournalNodeAt(LinkList *list, unsigned MAX_INT_TYPE position)
+{
+  LinkNode *node = list->head;
+
+  while (node && position--) node = node->next;
+  return node;
+}
+
+void _LLJournalDiscard(LinkList *list, LinkNode *node)
+{
+  if (!node) return;
+  LLRemoveNode(list, node);
+  LNDelete(node);
+}
+
+/* Applies one log's records above snapLsn; a torn tail simply ends it */
+void _LLJournalReplay(LLJournal *journal, const char *path, unsigned long snapLsn)
+{
+  FILE *file = fopen(path, "rb");
+  LinkList *scratch;
+  LLReader reader;
+  LinkNode *node;
+  unsigned MAX_INT_TYPE position;
+  unsigned long lsn;
+  int op;
+
+  if (!file) return;
+
+  memset(&reader, 0L, sizeof(LLReader));
+  scratch = LLCreate();
+  if (scratch && LLReaderInitFile(&reader, file))
+  {
+    while ((op = LLReadByte(&reader)) >= 0)
+    {
+      lsn = (unsigned long)LLReadVarint(&reader);
+      if (reader.failed) break;
+
+      /* Each record is read in full before it is applied */
+      if (op == LL_JOURNAL_PUSH)
+      {
+        if (!(node = LLReadNode(&reader, scratch))) break;
+        LLRemoveNode(scratch, node);
+        if (lsn > snapLsn) LLPush(journal->list, node);
+        else LNDelete(node);
+      }
+      else if (op == LL_JOURNAL_REMOVE)
+      {
+        position = LLReadVarint(&reader);
+        if (reader.failed) break;
+        if (lsn > snapLsn) _LLJournalDiscard(journal->list, _LLJournalNodeAt(journal->list, position));
+      }
+      else if (op == LL_JOURNAL_POP)
+      {
+        if (lsn > snapLsn) _LLJournalDiscard(journal->list, journal->list->tail);
+      }
+      else if (op == LL_JOURNAL_DEQUEUE)
+      {
+        if (lsn > snapLsn) _LLJournalDiscard(journal->list, journal->list->head);
+      }
+      else break;
+
+      if (lsn > journal->lsn) journal->lsn = lsn;
+    }
+  }
+
+  LLReaderFinish(&reader);
+  if (scratch) LLDelete(scratch);
+  fclose(file);
+}
+
+LLBoolean _LLJournalLoad(LLJournal *journal)
+{
+  char *snap = _LLJournalPath(journal->path, ".snap");
+  char *old = _LLJournalPath(journal->path, ".old");
+  char *log = _LLJournalPath(journal->path, ".log");
+  unsigned long snapLsn = 0;
+  LLBoolean ok = snap && old && log ? Yes : No;
+  LLReader reader;
+  FILE *file;
+
+  memset(&reader, 0L, sizeof(LLReader));
+  if (ok && (file = fopen(snap, "rb")) != NULL)
+  {
+    if (LLReaderInitFile(&reader, file))
+    {
+      snapLsn = (unsigned long)LLReadVarint(&reader);
+      LLReadList(&reader, journal->list);
+      if (!reader.finished) ok = No;
+    }
+    else ok = No;
+
+    LLReaderFinish(&reader);
+    fclose(file);
+  }
+
+  if (ok)
+  {
+    journal->lsn = snapLsn;
+    _LLJournalReplay(journal, old, snapLsn);
+    _LLJournalReplay(journal, log, snapLsn);
+  }
+
+  free(snap);
+  free(old);
+  free(log);
+  return ok;
+}
+
+/* The log's sink counts what reaches the file, so a record can be
+ * located and cut back out of it */
+size_t _LLJournalWrite(const void *bytes, size_t length, LLVoid context)
+{
+  LLJournal *journal = (LLJournal *)context;
+  size_t written = fwrite(bytes, 1, length, journal->log);
+
+  journal->logSize += written;
+  if (written != length) journal->logFailed = Yes;
+  return written;
+}
+
+LLBoolean _LLJournalStartLog(LLJournal *journal, FILE *file)
+{
+  if (journal->log) fclose(journal->log);
+  journal->log = file;
+  journal->pending = 0;
+  journal->logSize = 0;
+  journal->logFailed = No;
+
+  LLWriterInit(&journal->writer, _LLJournalWrite, journal);
+  return LLJournalSync(journal);
+}
+
+/* Takes the record in progress back out of the staging buffer, or off the
+ * end of the file if part of it was flushed. A record the writer refused
+ * leaves the journal usable; one the file refused leaves it failed. */
+void _LLJournalRollback(LLJournal *journal)
+{
+  journal->lsn--;
+
+  if (journal->logSize <= journal->recordStart)
+  {
+    journal->writer.used = journal->recordStart - journal->logSize;
+  }
+  else
+  {
+    journal->writer.used = 0;
+
+    #ifdef LL_JOURNAL_POSIX
+    if (fflush(journal->log) != 0 || ftruncate(fileno(journal->log), (off_t)journal->recordStart) != 0
+      || fseek(journal->log, (long)journal->recordStart, SEEK_SET) != 0)
+    {
+      journal->logFailed = Yes;
+    }
+    #else
+    journal->logFailed = Yes;
+    #endif
+
+    journal->logSize = journal->recordStart;
+  }
+
+  journal->writer.failed = journal->logFailed;
+}
+
+/* Stages an operation header; the payload, if any, follows */
+LLBoolean _LLJournalBegin(LLJournal *journal, int op)
+{
+  if (journal->writer.failed) return No;
+
+  journal->recordStart = journal->logSize + journal->writer.used;
+  LLWriteByte(&journal->writer, (unsigned char)op);
+  LLWriteVarint(&journal->writer, ++journal->lsn);
+  if (!journal->writer.failed) return Yes;
+
+  _LLJournalRollback(journal);
+  return No;
+}
+
+/* Group commit: sync once the batch fills or its oldest record is late.
+ * A record that fails here is rolled back, so the caller must leave the
+ * list as it was. */
+LLBoolean _LLJournalStaged(LLJournal *journal)
+{
+  unsigned long now = journal->maxDelay ? _LLJournalClock() : 0;
+
+  if (!journal->writer.failed)
+  {
+    if (!journal->pending++) journal->pendingSince = now;
+
+    if (journal->pending < journal->batchSize
+      && !(journal->maxDelay && now - journal->pendingSince >= journal->maxDelay))
+    {
+      return Yes;
+    }
+    if (LLJournalSync(journal)) return Yes;
+  }
+
+  _LLJournalRollback(journal);
+  return No;
+}
+
+LinkNode *_LLJournalPushValue(LLJournal *journal, LLVoid value, LinkNodeDataType type)
+{
+  LinkNode *node;
+
+  if (!value) return NULL;
+  if (!(node = LNCreate(value, type))) return NULL;
+
+  if (!LLJournalPush(journal, node))
+  {
+    LNDelete(node);
+    return NULL;
+  }
+
+  return node;
+}
+
+#pragma mark - Creation Functions
+
+LLJournal *LLJournalOpen(const char *path, size_t batchSize, unsigned long maxDelay)
+{
+  LLJournal *journal = (LLJournal *)malloc(sizeof(LLJournal));
+  char *log = NULL;
+  FILE *file;
+
+  if (!journal) return NULL;
+  memset(journal, 0L, sizeof(LLJournal));
+
+  journal->batchSize = batchSize ? batchSize : 1;
+  journal->maxDelay = maxDelay;
+  journal->list = LLCreate();
+  journal->path = _LLJournalPath(path, "");
+  log = _LLJournalPath(path, ".log");
+  if (!journal->list || !journal->path || !log) goto fail;
+
+  /* Recover, then fold everything into a snapshot and start a clean log */
+  if (!_LLJournalLoad(journal)) goto fail;
+  if (!_LLJournalFold(journal->list, journal->lsn, journal->path)) goto fail;
+  if (!(file = fopen(log, "wb"))) goto fail;
+  if (!_LLJournalStartLog(journal, file)) goto fail;
+
+  free(log);
+  return journal;
+
+fail:
+  free(log);
+  LLJournalClose(journal);
+  return NULL;
+}
+
+#pragma mark - Deallocation Functions
+
+LLBoolean LLJournalClose(LLJournal *journal)
+{
+  LLBoolean ok = Yes;
+
+  if (!journal) return No;
+
+  if (journal->log)
+  {
+    ok = LLJournalSync(journal);
+    if (fclose(journal->log) != 0) ok = No;
+  }
+
+  #ifdef LL_JOURNAL_POSIX
+  if (journal->compactor > 0) waitpid((pid_t)journal->compactor, NULL, 0);
+  #endif
+
+  if (journal->list) LLDelete(journal->list);
+  free(journal->path);
+  free(journal);
+  return ok;
+}
+
+#pragma mark - Journal Push Functions
+
+LinkNode *LLJournalPush(LLJournal *journal, LinkNode *node)
+{
+  int unkeyedType;
+
+  if (!node || !node->value) return NULL;
+
+  unkeyedType = node->type & LN_TYPE_MASK;
+  if (unkeyedType == LN_VOID || unkeyedType == LN_USER) return NULL;
+
+  if (!_LLJournalBegin(journal, LL_JOURNAL_PUSH)) return NULL;
+  LLWriteNode(&journal->writer, node);
+  if (!_LLJournalStaged(journal)) return NULL;
+
+  LLPush(journal->list, node);
+  return node;
+}
+
+LinkNode *LLJournalPushBoolean(LLJournal *journal, LLBoolean boolean)
+{
+  return _LLJournalPushValue(journal, LNBCreate(boolean), LN_BOOLEAN);
+}
+
+LinkNode *LLJournalPushInteger(LLJournal *journal, MAX_INT_TYPE value, LLIntegerType type)
+{
+  return _LLJournalPushValue(journal, LNICreate(value, type), LN_INTEGER);
+}
+
+LinkNode *LLJournalPushDecimal(LLJournal *journal, MAX_DEC_TYPE value, LLDecimalType type)
+{
+  return _LLJournalPushValue(journal, LNDCreate(value, type), LN_DECIMAL);
+}
+
+LinkNode *LLJournalPushString(LLJournal *journal, LLVoid string, LLStringType type)
+{
+  return _LLJournalPushValue(journal, LNSCreate(string, type), LN_STRING);
+}
+
+LinkNode *LLJournalPushKeyedBoolean(LLJournal *journal, LLKey key, LLBoolean boolean)
+{
+  return _LLJournalPushValue(journal, LNKBCreate(key, boolean), LN_BOOLEAN | LN_KEYED);
+}
+
+LinkNode *LLJournalPushKeyedInteger(LLJournal *journal, LLKey key, MAX_INT_TYPE value, LLIntegerType type)
+{
+  return _LLJournalPushValue(journal, LNKICreate(key, value, type), LN_INTEGER | LN_KEYED);
+}
+
+LinkNode *LLJournalPushKeyedDecimal(LLJournal *journal, LLKey key, MAX_DEC_TYPE value, LLDecimalType type)
+{
+  return _LLJournalPushValue(journal, LNKDCreate(key, value, type), LN_DECIMAL | LN_KEYED);
+}
+
+LinkNode *LLJournalPushKeyedString(LLJournal *journal, LLKey key, LLVoid string, LLStringType type)
+{
+  return _LLJournalPushValue(journal, LNKSCreate(key, string, type), LN_STRING | LN_KEYED);
+}
+
+#pragma mark - Journal Removal Functions
+
+LinkNode *LLJournalPop(LLJournal *journal)
+{
+  if (!journal->list->tail || !_LLJournalBegin(journal, LL_JOURNAL_POP)) return NULL;
+  if (!_LLJournalStaged(journal)) return NULL;
+
+  return LLPopNode(journal->list);
+}
+
+LinkNode *LLJournalDequeue(LLJournal *journal)
+{
+  if (!journal->list->head || !_LLJournalBegin(journal, LL_JOURNAL_DEQUEUE)) return NULL;
+  if (!_LLJournalStaged(journal)) return NULL;
+
+  return LLDequeueNode(journal->list);
+}
+
+LinkNode *LLJournalRemoveNode(LLJournal *journal, LinkNode *node)
+{
+  unsigned MAX_INT_TYPE position = 0;
+  LinkNode *cursor;
+
+  /* Replay has no node identity to go on, so removes log a position */
+  for (cursor = journal->list->head; cursor && cursor != node; cursor = cursor->next) position++;
+  if (!cursor || !_LLJournalBegin(journal, LL_JOURNAL_REMOVE)) return NULL;
+
+  LLWriteVarint(&journal->writer, position);
+  if (!_LLJournalStaged(journal)) return NULL;
+
+  LLRemoveNode(journal->list, node);
+  return node;
+}
+
+#pragma mark - Durability Functions
+
+LLBoolean LLJournalSync(LLJournal *journal)
+{
+  if (!LLWriterFlush(&journal->writer) || !_LLJournalFsync(journal->log))
+  {
+    journal->writer.failed = Yes;
+    journal->logFailed = Yes;
+    return No;
+  }
+
+  journal->pending = 0;
+  journal->durableLsn = journal->lsn;
+  return Yes;
+}
+
+LLBoolean LLJournalTick(LLJournal *journal)
+{
+  if (journal->writer.failed) return No;
+  if (!journal->pending || !journal->maxDelay) return Yes;
+  if (_LLJournalClock() - journal->pendingSince < journal->maxDelay) return Yes;
+
+  return LLJournalSync(journal);
+}
+
+LLBoolean LLJournalCompact(LLJournal *journal)
+{
+  char *log = _LLJournalPath(journal->path, ".log");
+  char *old = _LLJournalPath(journal->path, ".old");
+  LLBoolean ok = No;
+  FILE *file;
+  #ifdef LL_JOURNAL_POSIX
+  pid_t child;
+  #endif
+
+  if (!log || !old || LLJournalCompacting(journal) || !LLJournalSync(journal)) goto done;
+
+  /* A compaction that died left its log behind; fold it in right here */
+  if (_LLJournalExists(old) && !_LLJournalFold(journal->list, journal->lsn, journal->path)) goto done;
+
+  /* New records go to a fresh log; the retired one covers up to lsn */
+  if (rename(log, old) != 0) goto done;
+  if (!(file = fopen(log, "wb")))
+  {
+    rename(old, log);
+    goto done;
+  }
+  if (!_LLJournalStartLog(journal, file)) goto done;
+
+  /* The retired log must stay retired, and the new one exist, after a crash */
+  if (!_LLJournalSyncDir(log)) goto done;
+
+  #ifdef LL_JOURNAL_POSIX
+  /* The child sees the list frozen at lsn and writes it while we carry on */
+  child = fork();
+  if (child == 0) _exit(_LLJournalFold(journal->list, journal->lsn, journal->path) ? 0 : 1);
+  if (child > 0)
+  {
+    journal->compactor = (long)child;
+    ok = Yes;
+    goto done;
+  }
+  #endif
+
+  ok = _LLJournalFold(journal->list, journal->lsn, journal->path);
+
+done:
+  free(log);
+  free(old);
+  return ok;
+}
+
+LLBoolean LLJournalCompacting(LLJournal *journal)
+{
+  #ifdef LL_JOURNAL_POSIX
+  if (journal->compactor > 0)
+  {
+    if (waitpid((pid_t)journal->compactor, NULL, WNOHANG) == 0) return Yes;
+    journal->compactor = 0;
+  }
+  #endif
+
+  return No;
+}
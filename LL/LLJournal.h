@@ -0,0 +1,106 @@
+#ifndef LL_JOURNAL_H
+#define LL_JOURNAL_H
+
+#include "LLSerialize.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A journal keeps a list durable by appending every change to a write
+ * ahead log before applying it. Three files share the journal's path:
+ *
+ *   path.snap   LLSerialize stream: varint lsn, then the list at that lsn
+ *   path.log    LLSerialize header, then records  op varint-lsn payload
+ *   path.old    the previous log while a compaction is in flight
+ *
+ * Payloads are a node record for pushes, a varint position for removes
+ * and nothing for pops and dequeues. Records are staged in memory and
+ * fsync'd as a group once batchSize are pending or the oldest has waited
+ * maxDelay milliseconds, so an operation is durable once its lsn is at or
+ * below durableLsn. The delay is checked as each operation is logged and
+ * by LLJournalTick, which callers whose operations may pause should call
+ * periodically; LLJournalClose syncs whatever remains. Void and user
+ * nodes hold process local pointers and cannot be journaled; pushing one
+ * fails.
+ *
+ * An operation that cannot be logged or synced fails without touching
+ * the list, and its record is rolled back out of the log. A failed write
+ * or fsync leaves the journal failed; reopen it to recover. */
+#define LL_JOURNAL_PUSH     1
+#define LL_JOURNAL_POP      2
+#define LL_JOURNAL_DEQUEUE  3
+#define LL_JOURNAL_REMOVE   4
+
+#pragma mark - Types
+
+typedef struct LLJournal
+{
+  LinkList *list;
+  char *path;
+  FILE *log;
+  LLWriter writer;
+
+  /* Bytes handed to the log file, and where the record in progress starts */
+  size_t logSize;
+  size_t recordStart;
+  LLBoolean logFailed;
+
+  unsigned long lsn;
+  unsigned long durableLsn;
+  size_t batchSize;
+  unsigned long maxDelay;
+  size_t pending;
+  unsigned long pendingSince;
+  long compactor;
+} LLJournal;
+
+#pragma mark - Creation Functions
+
+/** Replays path.snap and path.log into a fresh list, then checkpoints */
+LLJournal *LLJournalOpen(const char *path, size_t batchSize, unsigned long maxDelay);
+
+#pragma mark - Deallocation Functions
+
+/** Syncs, waits for any compaction and deletes the journal's list */
+LLBoolean LLJournalClose(LLJournal *journal);
+
+#pragma mark - Journal Push Functions
+
+LinkNode *LLJournalPush(LLJournal *journal, LinkNode *node);
+LinkNode *LLJournalPushBoolean(LLJournal *journal, LLBoolean boolean);
+LinkNode *LLJournalPushInteger(LLJournal *journal, MAX_INT_TYPE value, LLIntegerType type);
+LinkNode *LLJournalPushDecimal(LLJournal *journal, MAX_DEC_TYPE value, LLDecimalType type);
+LinkNode *LLJournalPushString(LLJournal *journal, LLVoid string, LLStringType type);
+LinkNode *LLJournalPushKeyedBoolean(LLJournal *journal, LLKey key, LLBoolean boolean);
+LinkNode *LLJournalPushKeyedInteger(LLJournal *journal, LLKey key, MAX_INT_TYPE value, LLIntegerType type);
+LinkNode *LLJournalPushKeyedDecimal(LLJournal *journal, LLKey key, MAX_DEC_TYPE value, LLDecimalType type);
+LinkNode *LLJournalPushKeyedString(LLJournal *journal, LLKey key, LLVoid string, LLStringType type);
+
+#pragma mark - Journal Removal Functions
+
+/* Each returns the detached node, which the caller must LNDelete */
+LinkNode *LLJournalPop(LLJournal *journal);
+LinkNode *LLJournalDequeue(LLJournal *journal);
+LinkNode *LLJournalRemoveNode(LLJournal *journal, LinkNode *node);
+
+#pragma mark - Durability Functions
+
+/** Writes and fsyncs every pending record */
+LLBoolean LLJournalSync(LLJournal *journal);
+
+/** Syncs once the oldest pending record has waited maxDelay; No if the
+ * journal has failed */
+LLBoolean LLJournalTick(LLJournal *journal);
+
+/** Starts folding the log into a new snapshot; forks where available */
+LLBoolean LLJournalCompact(LLJournal *journal);
+
+/** Reaps a finished compaction; Yes while one is still running */
+LLBoolean LLJournalCompacting(LLJournal *journal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
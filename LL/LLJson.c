@@ -0,0 +1,715 @@
+#include "LLJson.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BIG_TYPES
+#define LL_JSON_INTEGER LLIN_LONG_LONG
+#else
+#define LL_JSON_INTEGER LLIN_LONG
+#endif
+
+/* Two digit pairs let the integer formatter retire a division per pair */
+static const char _LLJsonDigits[] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+  "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+static const double _LLJsonPowers[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+  1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17
+};
+
+typedef struct LLJsonParser
+{
+  char *cursor;
+  char *end;
+  const LLJsonHandler *handler;
+  LLVoid context;
+} LLJsonParser;
+
+typedef struct LLJsonBuilder
+{
+  LinkList *list;
+  char *key;
+  int depth;
+  LLBoolean isObject;
+  long count;
+} LLJsonBuilder;
+
+#pragma mark - Internal Helper Functions
+
+LLBoolean _LLJsonLiteral(LLWriter *writer, const char *text)
+{
+  LLWriteBytes(writer, text, strlen(text));
+  return writer->failed ? No : Yes;
+}
+
+/* Integer keys have no JSON form that reads back as one */
+LLBoolean _LLJsonHasIntKeys(LinkList *list)
+{
+  LinkNode *node;
+
+  for (node = list->head; node; node = node->next) if (node->type & LN_INT_KEYED) return Yes;
+  return No;
+}
+
+size_t _LLJsonUTF8(char *dest, unsigned long point)
+{
+  if (point < 0x80)
+  {
+    dest[0] = (char)point;
+    return 1;
+  }
+  if (point < 0x800)
+  {
+    dest[0] = (char)(0xc0 | (point >> 6));
+    dest[1] = (char)(0x80 | (point & 0x3f));
+    return 2;
+  }
+  if (point < 0x10000)
+  {
+    dest[0] = (char)(0xe0 | (point >> 12));
+    dest[1] = (char)(0x80 | ((point >> 6) & 0x3f));
+    dest[2] = (char)(0x80 | (point & 0x3f));
+    return 3;
+  }
+
+  dest[0] = (char)(0xf0 | (point >> 18));
+  dest[1] = (char)(0x80 | ((point >> 12) & 0x3f));
+  dest[2] = (char)(0x80 | ((point >> 6) & 0x3f));
+  dest[3] = (char)(0x80 | (point & 0x3f));
+  return 4;
+}
+
+#ifdef WCHAR_SUPPORT
+LLBoolean _LLJsonWriteWide(LLWriter *writer, const wchar_t *string)
+{
+  char chunk[256];
+  size_t used = 0;
+
+  /* Transcoded a chunk at a time, then escaped like any narrow string */
+  LLWriteByte(writer, '"');
+  for (; *string; string++)
+  {
+    if (used > sizeof(chunk) - 4)
+    {
+      LLJsonWriteString(writer, chunk, used);
+      used = 0;
+    }
+    used += _LLJsonUTF8(chunk + used, (unsigned long)*string);
+  }
+  LLJsonWriteString(writer, chunk, used);
+  LLWriteByte(writer, '"');
+  return writer->failed ? No : Yes;
+}
+#endif
+
+#pragma mark - Number Formatting Functions
+
+size_t LLJsonFormatInteger(char *buffer, MAX_INT_TYPE value, LLBoolean isUnsigned)
+{
+  unsigned MAX_INT_TYPE magnitude = (unsigned MAX_INT_TYPE)value;
+  char digits[LL_JSON_NUMBER];
+  size_t count = sizeof(digits), length = 0, pair;
+
+  if (!isUnsigned && value < 0)
+  {
+    buffer[length++] = '-';
+    magnitude = 0 - magnitude;
+  }
+
+  /* Digits are produced right to left, then copied out in one go */
+  while (magnitude >= 100)
+  {
+    pair = (size_t)(magnitude % 100) * 2;
+    magnitude /= 100;
+    digits[--count] = _LLJsonDigits[pair + 1];
+    digits[--count] = _LLJsonDigits[pair];
+  }
+  if (magnitude >= 10)
+  {
+    pair = (size_t)magnitude * 2;
+    digits[--count] = _LLJsonDigits[pair + 1];
+    digits[--count] = _LLJsonDigits[pair];
+  }
+  else digits[--count] = (char)('0' + magnitude);
+
+  memcpy(buffer + length, digits + count, sizeof(digits) - count);
+  return length + sizeof(digits) - count;
+}
+
+size_t LLJsonFormatDecimal(char *buffer, double value, LLBoolean isFloat)
+{
+  double limit = sizeof(unsigned MAX_INT_TYPE) >= 8 ? 9007199254740992.0 : 4294967295.0;
+  double magnitude, scaled;
+  unsigned MAX_INT_TYPE mantissa;
+  char digits[LL_JSON_NUMBER];
+  size_t length = 0, count, whole;
+  int places, precision;
+
+  /* JSON has no spelling for NaN or the infinities */
+  if (value != value || value - value != 0)
+  {
+    memcpy(buffer, "null", 4);
+    return 4;
+  }
+  if (value == 0)
+  {
+    buffer[0] = '0';
+    return 1;
+  }
+
+  magnitude = value < 0 ? -value : value;
+  if (value < 0) buffer[length++] = '-';
+
+  /* Shortest m / 10^places that reads back as value. With m below 2^53 and
+   * places at most 17 both operands are exact, so the division rounds the
+   * way a correct strtod would and the equality test proves round trip. */
+  for (places = 0; places < (int)(sizeof(_LLJsonPowers) / sizeof(double)); places++)
+  {
+    scaled = magnitude * _LLJsonPowers[places];
+    if (scaled >= limit) break;
+
+    mantissa = (unsigned MAX_INT_TYPE)(scaled + 0.5);
+    if (isFloat
+      ? (float)(mantissa / _LLJsonPowers[places]) != (float)magnitude
+      : mantissa / _LLJsonPowers[places] != magnitude) continue;
+
+    count = LLJsonFormatInteger(digits, (MAX_INT_TYPE)mantissa, Yes);
+    while (places && digits[count - 1] == '0') count--, places--;
+
+    if (count > (size_t)places)
+    {
+      whole = count - (size_t)places;
+      memcpy(buffer + length, digits, whole);
+      length += whole;
+    }
+    else
+    {
+      whole = 0;
+      buffer[length++] = '0';
+    }
+
+    if (places)
+    {
+      buffer[length++] = '.';
+      for (; (size_t)places > count; places--) buffer[length++] = '0';
+      memcpy(buffer + length, digits + whole, count - whole);
+      length += count - whole;
+    }
+
+    return length;
+  }
+
+  /* Very large or very small magnitudes; the rare case that needs libc */
+  for (precision = isFloat ? 6 : 15; precision < 17; precision++)
+  {
+    sprintf(buffer + length, "%.*g", precision, magnitude);
+    if (isFloat ? (float)strtod(buffer + length, NULL) == (float)magnitude
+      : strtod(buffer + length, NULL) == magnitude) break;
+  }
+  if (precision == 17) sprintf(buffer + length, "%.17g", magnitude);
+
+  return length + strlen(buffer + length);
+}
+
+#pragma mark - Emitter Functions
+
+LLBoolean LLJsonWriteString(LLWriter *writer, const char *string, size_t length)
+{
+  static const char hex[] = "0123456789abcdef";
+  const char *run = string, *end = string + length;
+  char escape[6];
+  unsigned char c;
+
+  /* Clean runs are copied whole; only the bytes JSON forbids are split out */
+  for (; string < end; string++)
+  {
+    c = (unsigned char)*string;
+    if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+    LLWriteBytes(writer, run, (size_t)(string - run));
+    run = string + 1;
+
+    escape[0] = '\\';
+    switch (c)
+    {
+      case '"': escape[1] = '"'; break;
+      case '\\': escape[1] = '\\'; break;
+      case '\b': escape[1] = 'b'; break;
+      case '\f': escape[1] = 'f'; break;
+      case '\n': escape[1] = 'n'; break;
+      case '\r': escape[1] = 'r'; break;
+      case '\t': escape[1] = 't'; break;
+      default:
+        memcpy(escape + 1, "u00", 3);
+        escape[4] = hex[c >> 4];
+        escape[5] = hex[c & 0xf];
+        LLWriteBytes(writer, escape, 6);
+        continue;
+    }
+    LLWriteBytes(writer, escape, 2);
+  }
+
+  LLWriteBytes(writer, run, (size_t)(end - run));
+  return writer->failed ? No : Yes;
+}
+
+LLBoolean LLJsonWriteValue(LLWriter *writer, LinkNode *node)
+{
+  LLBoolean isKeyed = node->type & LN_KEYED ? Yes : No;
+  LLIntegerNode *intNode;
+  LLDecimalNode *decNode;
+  LLStringNode *strNode;
+  char number[LL_JSON_NUMBER];
+  LLBoolean boolean;
+
+  if (!node->value) return _LLJsonLiteral(writer, "null");
+
+  switch (node->type & LN_TYPE_MASK)
+  {
+    case LN_BOOLEAN:
+      boolean = isKeyed ? ((LLKeyedBool *)node->value)->boolean : ((LLBoolNode *)node->value)->boolean;
+      return _LLJsonLiteral(writer, boolean ? "true" : "false");
+
+    case LN_INTEGER:
+      intNode = isKeyed ? &((LLKeyedInteger *)node->value)->integer : (LLIntegerNode *)node->value;
+      LLWriteBytes(writer, number,
+        LLJsonFormatInteger(number, LLIntegerValue(intNode), intNode->type & LLIN_UNSIGNED ? Yes : No));
+      return writer->failed ? No : Yes;
+
+    case LN_DECIMAL:
+      decNode = isKeyed ? &((LLKeyedDecimal *)node->value)->decimal : (LLDecimalNode *)node->value;
+      LLWriteBytes(writer, number,
+        LLJsonFormatDecimal(number, (double)LLDecimalValue(decNode), decNode->type == LLDN_FLOAT ? Yes : No));
+      return writer->failed ? No : Yes;
+
+    case LN_STRING:
+      strNode = isKeyed ? &((LLKeyedString *)node->value)->string : (LLStringNode *)node->value;
+      #ifdef WCHAR_SUPPORT
+      if (strNode->type == LLSN_WIDE) return _LLJsonWriteWide(writer, strNode->u.w);
+      #endif
+      LLWriteByte(writer, '"');
+      LLJsonWriteString(writer, strNode->u.s, strlen(strNode->u.s));
+      LLWriteByte(writer, '"');
+      return writer->failed ? No : Yes;
+  }
+
+  return _LLJsonLiteral(writer, "null");
+}
+
+LLBoolean LLJsonWriteObject(LLWriter *writer, LinkList *list)
+{
+  LLBoolean first = Yes;
+  LinkNode *node;
+  LLKey key;
+
+  if (_LLJsonHasIntKeys(list)) return No;
+
+  LLWriteByte(writer, '{');
+  for (node = list->head; node && !writer->failed; node = node->next)
+  {
+    if (!(node->type & LN_KEYED) || !node->value) continue;
+
+    key = ((LLKeyedNode *)node->value)->key;
+    if (!first) LLWriteByte(writer, ',');
+    LLWriteByte(writer, '"');
+    LLJsonWriteString(writer, key, strlen(key));
+    LLWriteBytes(writer, "\":", 2);
+    LLJsonWriteValue(writer, node);
+    first = No;
+  }
+  LLWriteByte(writer, '}');
+
+  return writer->failed ? No : Yes;
+}
+
+LLBoolean LLJsonWriteArray(LLWriter *writer, LinkList *list)
+{
+  LinkNode *node;
+
+  if (_LLJsonHasIntKeys(list)) return No;
+
+  LLWriteByte(writer, '[');
+  for (node = list->head; node && !writer->failed; node = node->next)
+  {
+    if (node != list->head) LLWriteByte(writer, ',');
+    LLJsonWriteValue(writer, node);
+  }
+  LLWriteByte(writer, ']');
+
+  return writer->failed ? No : Yes;
+}
+
+#pragma mark - Internal Parser Functions
+
+void _LLJsonSpace(LLJsonParser *parser)
+{
+  char c;
+
+  while (parser->cursor < parser->end)
+  {
+    c = *parser->cursor;
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+    parser->cursor++;
+  }
+}
+
+int _LLJsonHex(const char *text)
+{
+  int value = 0, i;
+  char c;
+
+  for (i = 0; i < 4; i++)
+  {
+    c = text[i];
+    value <<= 4;
+    if (c >= '0' && c <= '9') value |= c - '0';
+    else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+    else return -1;
+  }
+
+  return value;
+}
+
+/* Unescapes the string at the cursor over itself and NUL terminates it.
+ * Decoding never outgrows its source, so writes trail reads. */
+LLBoolean _LLJsonString(LLJsonParser *parser, char **string, size_t *length)
+{
+  char *read = parser->cursor + 1, *write, *end = parser->end;
+  unsigned long point;
+  int low;
+
+  /* Most strings have no escapes and are sliced without moving a byte */
+  while (read < end && *read != '"' && *read != '\\')
+  {
+    if ((unsigned char)*read < 0x20) return No;
+    read++;
+  }
+  write = read;
+
+  while (read < end && *read != '"')
+  {
+    if ((unsigned char)*read < 0x20) return No;
+    if (*read != '\\')
+    {
+      *write++ = *read++;
+      continue;
+    }
+
+    if (++read >= end) return No;
+    switch (*read++)
+    {
+      case '"': *write++ = '"'; break;
+      case '\\': *write++ = '\\'; break;
+      case '/': *write++ = '/'; break;
+      case 'b': *write++ = '\b'; break;
+      case 'f': *write++ = '\f'; break;
+      case 'n': *write++ = '\n'; break;
+      case 'r': *write++ = '\r'; break;
+      case 't': *write++ = '\t'; break;
+      case 'u':
+        if (end - read < 4 || (low = _LLJsonHex(read)) < 0) return No;
+        point = (unsigned long)low;
+        read += 4;
+
+        /* Surrogate pairs fold into one code point */
+        if (point >= 0xd800 && point < 0xdc00 && end - read >= 6 && read[0] == '\\' && read[1] == 'u'
+          && (low = _LLJsonHex(read + 2)) >= 0xdc00 && low < 0xe000)
+        {
+          point = 0x10000 + ((point - 0xd800) << 10) + ((unsigned long)low - 0xdc00);
+          read += 6;
+        }
+        write += _LLJsonUTF8(write, point);
+        break;
+      default:
+        return No;
+    }
+  }
+
+  if (read >= end) return No;
+
+  *string = parser->cursor + 1;
+  *length = (size_t)(write - *string);
+  *write = '\0';
+  parser->cursor = read + 1;
+  return Yes;
+}
+
+LLBoolean _LLJsonNumber(LLJsonParser *parser)
+{
+  const LLJsonHandler *handler = parser->handler;
+  unsigned MAX_INT_TYPE magnitude = 0, limit = ((unsigned MAX_INT_TYPE)~0) >> 1;
+  char *start = parser->cursor, *cursor = start, *end = parser->end;
+  LLBoolean negative = No, isInteger = Yes, overflow = No;
+  char local[64], *copy;
+  MAX_DEC_TYPE decimal;
+  size_t length;
+  int digit;
+
+  if (cursor < end && *cursor == '-') negative = Yes, cursor++;
+  if (cursor >= end || *cursor < '0' || *cursor > '9') return No;
+
+  if (*cursor == '0') cursor++;
+  else while (cursor < end && *cursor >= '0' && *cursor <= '9')
+  {
+    digit = *cursor++ - '0';
+    if (magnitude > (limit - digit) / 10) overflow = Yes;
+    else magnitude = magnitude * 10 + digit;
+  }
+
+  if (cursor < end && *cursor == '.')
+  {
+    isInteger = No;
+    if (++cursor >= end || *cursor < '0' || *cursor > '9') return No;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') cursor++;
+  }
+  if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+  {
+    isInteger = No;
+    if (++cursor < end && (*cursor == '+' || *cursor == '-')) cursor++;
+    if (cursor >= end || *cursor < '0' || *cursor > '9') return No;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') cursor++;
+  }
+  parser->cursor = cursor;
+
+  if (isInteger && !overflow)
+  {
+    return !handler->integer || handler->integer(negative ? -(MAX_INT_TYPE)magnitude : (MAX_INT_TYPE)magnitude, parser->context);
+  }
+
+  /* The slice is not terminated, so strtod reads a bounded copy */
+  length = (size_t)(cursor - start);
+  copy = length < sizeof(local) ? local : (char *)malloc(length + 1);
+  if (!copy) return No;
+  memcpy(copy, start, length);
+  copy[length] = '\0';
+  decimal = (MAX_DEC_TYPE)strtod(copy, NULL);
+  if (copy != local) free(copy);
+
+  return !handler->decimal || handler->decimal(decimal, parser->context);
+}
+
+LLBoolean _LLJsonExpect(LLJsonParser *parser, const char *word)
+{
+  size_t length = strlen(word);
+
+  if ((size_t)(parser->end - parser->cursor) < length || memcmp(parser->cursor, word, length) != 0) return No;
+  parser->cursor += length;
+  return Yes;
+}
+
+LLBoolean _LLJsonValue(LLJsonParser *parser, int depth)
+{
+  const LLJsonHandler *handler = parser->handler;
+  LLVoid context = parser->context;
+  char *string;
+  size_t length;
+
+  _LLJsonSpace(parser);
+  if (parser->cursor >= parser->end) return No;
+
+  switch (*parser->cursor)
+  {
+    case '{':
+      if (depth >= LL_JSON_DEPTH) return No;
+      parser->cursor++;
+      if (handler->beginObject && !handler->beginObject(context)) return No;
+
+      _LLJsonSpace(parser);
+      if (parser->cursor >= parser->end || *parser->cursor != '}') for (;;)
+      {
+        _LLJsonSpace(parser);
+        if (parser->cursor >= parser->end || *parser->cursor != '"') return No;
+        if (!_LLJsonString(parser, &string, &length)) return No;
+        if (handler->key && !handler->key(string, length, context)) return No;
+
+        _LLJsonSpace(parser);
+        if (parser->cursor >= parser->end || *parser->cursor++ != ':') return No;
+        if (!_LLJsonValue(parser, depth + 1)) return No;
+
+        _LLJsonSpace(parser);
+        if (parser->cursor >= parser->end) return No;
+        if (*parser->cursor == '}') break;
+        if (*parser->cursor++ != ',') return No;
+      }
+      parser->cursor++;
+
+      return !handler->endObject || handler->endObject(context);
+
+    case '[':
+      if (depth >= LL_JSON_DEPTH) return No;
+      parser->cursor++;
+      if (handler->beginArray && !handler->beginArray(context)) return No;
+
+      _LLJsonSpace(parser);
+      if (parser->cursor >= parser->end || *parser->cursor != ']') for (;;)
+      {
+        if (!_LLJsonValue(parser, depth + 1)) return No;
+
+        _LLJsonSpace(parser);
+        if (parser->cursor >= parser->end) return No;
+        if (*parser->cursor == ']') break;
+        if (*parser->cursor++ != ',') return No;
+      }
+      parser->cursor++;
+
+      return !handler->endArray || handler->endArray(context);
+
+    case '"':
+      if (!_LLJsonString(parser, &string, &length)) return No;
+      return !handler->string || handler->string(string, length, context);
+
+    case 't':
+      if (!_LLJsonExpect(parser, "true")) return No;
+      return !handler->boolean || handler->boolean(Yes, context);
+
+    case 'f':
+      if (!_LLJsonExpect(parser, "false")) return No;
+      return !handler->boolean || handler->boolean(No, context);
+
+    case 'n':
+      if (!_LLJsonExpect(parser, "null")) return No;
+      return !handler->null || handler->null(context);
+  }
+
+  return _LLJsonNumber(parser);
+}
+
+#pragma mark - Internal Builder Functions
+
+/* Scalars land in the list only at the top level or one level inside it */
+LLBoolean _LLJsonBuilderTakes(LLJsonBuilder *builder)
+{
+  return builder->depth <= 1 && (!builder->isObject || builder->key) ? Yes : No;
+}
+
+LLBoolean _LLJsonBuilderPushed(LLJsonBuilder *builder, LinkNode *node)
+{
+  builder->key = NULL;
+  if (!node) return No;
+  builder->count++;
+  return Yes;
+}
+
+LLBoolean _LLJsonBuilderBegin(LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  builder->key = NULL;
+  builder->depth++;
+  return Yes;
+}
+
+LLBoolean _LLJsonBuilderBeginObject(LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  if (!builder->depth) builder->isObject = Yes;
+  return _LLJsonBuilderBegin(context);
+}
+
+LLBoolean _LLJsonBuilderEnd(LLVoid context)
+{
+  ((LLJsonBuilder *)context)->depth--;
+  return Yes;
+}
+
+LLBoolean _LLJsonBuilderKey(char *key, size_t length, LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  (void)length;
+  if (builder->depth == 1) builder->key = key;
+  return Yes;
+}
+
+LLBoolean _LLJsonBuilderString(char *string, size_t length, LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  (void)length;
+  if (!_LLJsonBuilderTakes(builder)) return Yes;
+  return _LLJsonBuilderPushed(builder, builder->key
+    ? LLPushKeyedString(builder->list, builder->key, string, LLSN_STRING)
+    : LLPushString(builder->list, string, LLSN_STRING));
+}
+
+LLBoolean _LLJsonBuilderInteger(MAX_INT_TYPE value, LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  if (!_LLJsonBuilderTakes(builder)) return Yes;
+  return _LLJsonBuilderPushed(builder, builder->key
+    ? LLPushKeyedInteger(builder->list, builder->key, value, LL_JSON_INTEGER)
+    : LLPushInteger(builder->list, value, LL_JSON_INTEGER));
+}
+
+LLBoolean _LLJsonBuilderDecimal(MAX_DEC_TYPE value, LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  if (!_LLJsonBuilderTakes(builder)) return Yes;
+  return _LLJsonBuilderPushed(builder, builder->key
+    ? LLPushKeyedDecimal(builder->list, builder->key, value, LLDN_DOUBLE)
+    : LLPushDecimal(builder->list, value, LLDN_DOUBLE));
+}
+
+LLBoolean _LLJsonBuilderBoolean(LLBoolean value, LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  if (!_LLJsonBuilderTakes(builder)) return Yes;
+  return _LLJsonBuilderPushed(builder, builder->key
+    ? LLPushKeyedBoolean(builder->list, builder->key, value)
+    : LLPushBoolean(builder->list, value));
+}
+
+/* null has no node type of its own; a void node holding NULL writes back as null */
+LLBoolean _LLJsonBuilderNull(LLVoid context)
+{
+  LLJsonBuilder *builder = (LLJsonBuilder *)context;
+
+  if (!_LLJsonBuilderTakes(builder)) return Yes;
+  return _LLJsonBuilderPushed(builder, builder->key
+    ? LLPushKeyedVoid(builder->list, builder->key, NULL)
+    : LLPushVoid(builder->list, NULL));
+}
+
+#pragma mark - Parser Functions
+
+LLBoolean LLJsonParse(char *json, size_t length, const LLJsonHandler *handler, LLVoid context)
+{
+  LLJsonParser parser;
+
+  parser.cursor = json;
+  parser.end = json + length;
+  parser.handler = handler;
+  parser.context = context;
+
+  if (!_LLJsonValue(&parser, 0)) return No;
+
+  _LLJsonSpace(&parser);
+  return parser.cursor == parser.end ? Yes : No;
+}
+
+long LLJsonReadList(char *json, size_t length, LinkList *list)
+{
+  static const LLJsonHandler handler =
+  {
+    _LLJsonBuilderBeginObject, _LLJsonBuilderEnd,
+    _LLJsonBuilderBegin, _LLJsonBuilderEnd,
+    _LLJsonBuilderKey, _LLJsonBuilderString,
+    _LLJsonBuilderInteger, _LLJsonBuilderDecimal,
+    _LLJsonBuilderBoolean, _LLJsonBuilderNull
+  };
+  LLJsonBuilder builder;
+
+  memset(&builder, 0L, sizeof(LLJsonBuilder));
+  builder.list = list;
+
+  return LLJsonParse(json, length, &handler, &builder) ? builder.count : -1;
+}
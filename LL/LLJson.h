@@ -0,0 +1,71 @@
+#ifndef LL_JSON_H
+#define LL_JSON_H
+
+#include "LLSerialize.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* JSON is written through an LLWriter bound with LLWriterAttach, so the
+ * output streams through the writer's staging buffer; call LLWriterFlush
+ * when done. Keyed nodes become object members, everything else array
+ * elements. Void and user nodes are written as null. Lists holding
+ * LN_INT_KEYED nodes are refused before anything is written, as a member
+ * name would read back as a string key.
+ *
+ * Parsing is in situ: the input buffer must be writable. Strings are
+ * unescaped in place and NUL terminated, so handlers receive slices of
+ * the caller's buffer rather than copies. */
+#ifndef LL_JSON_DEPTH
+#define LL_JSON_DEPTH 64
+#endif
+
+/** Room for any number LLJsonFormatInteger or LLJsonFormatDecimal writes */
+#define LL_JSON_NUMBER 40
+
+#pragma mark - Types
+
+/* Each callback may be NULL; returning No stops the parse with an error */
+typedef struct LLJsonHandler
+{
+  LLBoolean (*beginObject)(LLVoid context);
+  LLBoolean (*endObject)(LLVoid context);
+  LLBoolean (*beginArray)(LLVoid context);
+  LLBoolean (*endArray)(LLVoid context);
+  LLBoolean (*key)(char *key, size_t length, LLVoid context);
+  LLBoolean (*string)(char *string, size_t length, LLVoid context);
+  LLBoolean (*integer)(MAX_INT_TYPE value, LLVoid context);
+  LLBoolean (*decimal)(MAX_DEC_TYPE value, LLVoid context);
+  LLBoolean (*boolean)(LLBoolean value, LLVoid context);
+  LLBoolean (*null)(LLVoid context);
+} LLJsonHandler;
+
+#pragma mark - Number Formatting Functions
+
+/* Both write into buffer without a terminator and return the length */
+size_t LLJsonFormatInteger(char *buffer, MAX_INT_TYPE value, LLBoolean isUnsigned);
+size_t LLJsonFormatDecimal(char *buffer, double value, LLBoolean isFloat);
+
+#pragma mark - Emitter Functions
+
+LLBoolean LLJsonWriteString(LLWriter *writer, const char *string, size_t length);
+LLBoolean LLJsonWriteValue(LLWriter *writer, LinkNode *node);
+LLBoolean LLJsonWriteObject(LLWriter *writer, LinkList *list);
+LLBoolean LLJsonWriteArray(LLWriter *writer, LinkList *list);
+
+#pragma mark - Parser Functions
+
+/** Reports json to handler event by event; Yes if it was well formed */
+LLBoolean LLJsonParse(char *json, size_t length, const LLJsonHandler *handler, LLVoid context);
+
+/** Pushes the members of a top level object as keyed nodes, or the
+ * elements of a top level array as plain nodes. Nested containers are
+ * skipped. Returns the number of nodes pushed, or -1 on a parse error. */
+long LLJsonReadList(char *json, size_t length, LinkList *list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
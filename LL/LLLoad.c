@@ -0,0 +1,541 @@
+#include "LLLoad.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(LL_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define LL_LOAD_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define LL_LOAD_STRING  0
+#define LL_LOAD_INTEGER 1
+#define LL_LOAD_DECIMAL 2
+
+static const double _LLLoadPowers[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+typedef struct LLLoadField
+{
+  const char *text;
+  size_t length;
+  size_t column;
+  MAX_INT_TYPE integer;
+  double decimal;
+  int kind;
+  LLBoolean quoted;
+} LLLoadField;
+
+typedef struct LLLoader
+{
+  LinkList *list;
+  LLLoadOptions options;
+  LLLoadField *fields;
+  size_t count;
+  size_t capacity;
+  char *names;
+  size_t namesSize;
+  size_t *nameOffsets;
+  LLKeyedNode *keys;
+  size_t columns;
+  LLBoolean needHeader;
+  LLBoolean failed;
+  long pushed;
+} LLLoader;
+
+#pragma mark - Internal Scanning Functions
+
+/* Finds the next delimiter or newline a word at a time. A byte equal to
+ * c leaves a zero in word ^ (c * ones), and (x - ones) & ~x & highs is
+ * non-zero exactly when x holds a zero byte. */
+const char *_LLLoadScan(const char *p, const char *end, char delimiter)
+{
+  const size_t ones = (size_t)-1 / 255, highs = ones * 0x80;
+  const size_t delimiters = ones * (unsigned char)delimiter, newlines = ones * '\n';
+  size_t word, x, y;
+
+  while ((size_t)(end - p) >= sizeof(size_t))
+  {
+    memcpy(&word, p, sizeof(size_t));
+    x = word ^ delimiters;
+    y = word ^ newlines;
+    if (((x - ones) & ~x & highs) | ((y - ones) & ~y & highs)) break;
+    p += sizeof(size_t);
+  }
+
+  while (p < end && *p != delimiter && *p != '\n') p++;
+  return p;
+}
+
+LLBoolean _LLLoadDigit(char c)
+{
+  return c >= '0' && c <= '9' ? Yes : No;
+}
+
+/* Accepts [sign] digits [. digits] [e [sign] digits] spanning the field */
+LLBoolean _LLLoadNumeric(const char *p, const char *end)
+{
+  LLBoolean digits = No;
+
+  if (p < end && (*p == '-' || *p == '+')) p++;
+  while (p < end && _LLLoadDigit(*p)) p++, digits = Yes;
+  if (p < end && *p == '.') for (p++; p < end && _LLLoadDigit(*p); p++) digits = Yes;
+  if (!digits) return No;
+
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    if (++p < end && (*p == '-' || *p == '+')) p++;
+    if (p >= end || !_LLLoadDigit(*p)) return No;
+    while (p < end && _LLLoadDigit(*p)) p++;
+  }
+
+  return p == end ? Yes : No;
+}
+
+/* Plain integers and short decimals are read by hand. A decimal whose
+ * digits fit below 2^53 with at most 22 places is exactly m / 10^k, one
+ * correctly rounded division; anything longer goes to strtod. */
+int _LLLoadNumber(const char *text, size_t length, MAX_INT_TYPE *integer, double *decimal)
+{
+  const unsigned MAX_INT_TYPE limit = ((unsigned MAX_INT_TYPE)~0) >> 1;
+  const char *p = text, *end = text + length;
+  unsigned MAX_INT_TYPE mantissa = 0;
+  LLBoolean negative = No, exact = Yes;
+  int digits = 0, places = 0;
+  char local[64];
+
+  if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-' ? Yes : No;
+
+  for (; p < end && _LLLoadDigit(*p); p++, digits++)
+  {
+    if (digits < 18) mantissa = mantissa * 10 + (unsigned MAX_INT_TYPE)(*p - '0');
+    else exact = No;
+  }
+
+  if (p == end && digits && exact && mantissa <= limit)
+  {
+    *integer = negative ? -(MAX_INT_TYPE)mantissa : (MAX_INT_TYPE)mantissa;
+    return LL_LOAD_INTEGER;
+  }
+
+  if (p < end && *p == '.')
+  {
+    for (p++; p < end && _LLLoadDigit(*p); p++, digits++, places++)
+    {
+      if (digits < 18) mantissa = mantissa * 10 + (unsigned MAX_INT_TYPE)(*p - '0');
+      else exact = No;
+    }
+  }
+
+  if (p == end && digits && exact && places <= 22 && mantissa < ((unsigned MAX_INT_TYPE)1 << 53))
+  {
+    *decimal = (double)mantissa / _LLLoadPowers[places];
+    if (negative) *decimal = -*decimal;
+    return LL_LOAD_DECIMAL;
+  }
+
+  /* Exponents, long mantissas and big integers; strtod reads a copy since
+   * the field is not terminated */
+  if (length >= sizeof(local) || !_LLLoadNumeric(text, end)) return LL_LOAD_STRING;
+
+  memcpy(local, text, length);
+  local[length] = '\0';
+  *decimal = strtod(local, NULL);
+  return LL_LOAD_DECIMAL;
+}
+
+#pragma mark - Internal Loader Functions
+
+LLLoadField *_LLLoadStage(LLLoader *loader, const char *text, size_t length, LLBoolean quoted, size_t column)
+{
+  LLLoadField *field, *grown;
+  size_t capacity;
+
+  if (loader->count == loader->capacity)
+  {
+    capacity = loader->capacity ? loader->capacity << 1 : LL_LOAD_BATCH;
+    grown = (LLLoadField *)realloc(loader->fields, capacity * sizeof(LLLoadField));
+    if (!grown) return NULL;
+
+    loader->fields = grown;
+    loader->capacity = capacity;
+  }
+
+  field = &loader->fields[loader->count++];
+  field->text = text;
+  field->length = length;
+  field->column = column;
+  field->quoted = quoted;
+  field->kind = LL_LOAD_STRING;
+  return field;
+}
+
+/* Finds the end of an unquoted field and reads it as a number on the
+ * same pass; only fields that stop looking like a plain number fall back
+ * to the word scan and _LLLoadNumber */
+const char *_LLLoadParse(const char *p, const char *end, char delimiter, LLLoadField *field)
+{
+  const char *start = field->text, *dot = NULL, *stop;
+  unsigned MAX_INT_TYPE mantissa = 0;
+  int digits = 0;
+
+  if (p < end && (*p == '-' || *p == '+')) p++;
+  for (; p < end && (unsigned char)(*p - '0') < 10; p++, digits++) mantissa = mantissa * 10 + (unsigned MAX_INT_TYPE)(*p - '0');
+  if (p < end && *p == '.')
+  {
+    dot = p;
+    for (p++; p < end && (unsigned char)(*p - '0') < 10; p++, digits++) mantissa = mantissa * 10 + (unsigned MAX_INT_TYPE)(*p - '0');
+  }
+
+  stop = p;
+  if (p < end && *p == '\r' && (p + 1 == end || p[1] == '\n')) p++;
+
+  if (p < end && *p != delimiter && *p != '\n')
+  {
+    p = _LLLoadScan(p, end, delimiter);
+    stop = p > start && p[-1] == '\r' && (p == end || *p == '\n') ? p - 1 : p;
+    digits = 0;
+  }
+
+  field->length = (size_t)(stop - start);
+
+  /* Up to 15 digits always fits both an integer and a double's mantissa */
+  if (digits && digits <= 15)
+  {
+    if (!dot)
+    {
+      field->integer = *start == '-' ? -(MAX_INT_TYPE)mantissa : (MAX_INT_TYPE)mantissa;
+      field->kind = LL_LOAD_INTEGER;
+    }
+    else
+    {
+      field->decimal = (double)mantissa / _LLLoadPowers[stop - dot - 1];
+      if (*start == '-') field->decimal = -field->decimal;
+      field->kind = LL_LOAD_DECIMAL;
+    }
+  }
+  else if (field->length)
+  {
+    field->kind = _LLLoadNumber(start, field->length, &field->integer, &field->decimal);
+  }
+
+  return p;
+}
+
+/* Writes a field's text into the arena, collapsing "" inside quotes */
+size_t _LLLoadCopy(char *dest, LLLoadField *field)
+{
+  const char *source = field->text, *end = field->text + field->length;
+  char *start = dest;
+
+  if (!field->quoted)
+  {
+    memcpy(dest, source, field->length);
+    dest[field->length] = '\0';
+    return field->length + 1;
+  }
+
+  while (source < end)
+  {
+    *dest = *source++;
+    if (*dest++ == '"' && source < end && *source == '"') source++;
+  }
+  *dest++ = '\0';
+
+  return (size_t)(dest - start);
+}
+
+/* The header record's fields become the column names */
+LLBoolean _LLLoadColumns(LLLoader *loader, size_t first)
+{
+  size_t count = loader->count - first, size = 0, i;
+  LLLoadField *field;
+
+  for (i = first; i < loader->count; i++) size += loader->fields[i].length + 1;
+
+  loader->names = (char *)malloc(size ? size : 1);
+  loader->nameOffsets = (size_t *)malloc((count ? count : 1) * sizeof(size_t));
+  loader->keys = (LLKeyedNode *)malloc((count ? count : 1) * sizeof(LLKeyedNode));
+  if (!loader->names || !loader->nameOffsets || !loader->keys) return No;
+
+  for (i = 0, size = 0; i < count; i++)
+  {
+    field = &loader->fields[first + i];
+    loader->nameOffsets[i] = size;
+    size += _LLLoadCopy(loader->names + size, field);
+  }
+
+  loader->namesSize = size;
+  loader->columns = count;
+  loader->count = first;
+  loader->needHeader = No;
+  return Yes;
+}
+
+/* Pushes the staged fields out of one block sized for them exactly */
+LLBoolean _LLLoadFlush(LLLoader *loader)
+{
+  LLLoadField *field;
+  LLBlockNode *nodes, *slot;
+  LLBoolean isKeyed;
+  size_t arenaSize = loader->namesSize, i;
+  char *arena;
+
+  if (!loader->count) return Yes;
+
+  for (i = 0; i < loader->count; i++)
+  {
+    if (loader->fields[i].kind == LL_LOAD_STRING) arenaSize += loader->fields[i].length + 1;
+  }
+
+  nodes = LLNodeBlockCreate(loader->count, arenaSize, &arena);
+  if (!nodes) return No;
+
+  /* Each block carries its own copy of the names its keys point at */
+  if (loader->columns)
+  {
+    memcpy(arena, loader->names, loader->namesSize);
+    for (i = 0; i < loader->columns; i++) LNKSetKey(&loader->keys[i], arena + loader->nameOffsets[i]);
+    arena += loader->namesSize;
+  }
+
+  for (i = 0; i < loader->count; i++)
+  {
+    field = &loader->fields[i];
+    slot = &nodes[i];
+    isKeyed = field->column < loader->columns ? Yes : No;
+
+    switch (field->kind)
+    {
+      case LL_LOAD_INTEGER:
+        if (isKeyed) slot->u.ki.keyedNode = loader->keys[field->column];
+        LNSetIntByType(isKeyed ? &slot->u.ki.integer : &slot->u.i, LLIN_LONG, field->integer);
+        slot->link.type |= LN_INTEGER;
+        break;
+
+      case LL_LOAD_DECIMAL:
+        if (isKeyed) slot->u.kd.keyedNode = loader->keys[field->column];
+        LNSetDecByType(isKeyed ? &slot->u.kd.decimal : &slot->u.d, LLDN_DOUBLE, field->decimal);
+        slot->link.type |= LN_DECIMAL;
+        break;
+
+      default:
+        if (isKeyed) slot->u.ks.keyedNode = loader->keys[field->column];
+        (isKeyed ? &slot->u.ks.string : &slot->u.s)->u.s = arena;
+        (isKeyed ? &slot->u.ks.string : &slot->u.s)->type = LLSN_STRING;
+        arena += _LLLoadCopy(arena, field);
+        slot->link.type |= LN_STRING;
+        break;
+    }
+
+    if (isKeyed) slot->link.type |= LN_KEYED;
+  }
+
+  LLPushBlock(loader->list, nodes, loader->count);
+  loader->pushed += (long)loader->count;
+  loader->count = 0;
+  return Yes;
+}
+
+/* Stages every complete record in data and returns the bytes they span;
+ * unless final, a record running off the end is left for the next call */
+size_t _LLLoadRecords(LLLoader *loader, const char *data, size_t length, LLBoolean final)
+{
+  const char *p = data, *end = data + length, *record, *q, *close;
+  char delimiter = loader->options.delimiter;
+  size_t mark, column, fieldLength;
+  LLLoadField *field;
+  LLBoolean parse;
+
+  while (p < end && !loader->failed)
+  {
+    record = p;
+    mark = loader->count;
+    parse = loader->options.numbers && !loader->needHeader ? Yes : No;
+
+    for (column = 0; ; column++)
+    {
+      if (delimiter && p < end && *p == '"')
+      {
+        for (q = p + 1; ; q = close + 2)
+        {
+          close = (const char *)memchr(q, '"', (size_t)(end - q));
+          if (!close || (close + 1 == end && !final)) goto incomplete;
+          if (close + 1 == end || close[1] != '"') break;
+        }
+
+        if (!_LLLoadStage(loader, p + 1, (size_t)(close - p - 1), Yes, column)) goto failed;
+        q = _LLLoadScan(close + 1, end, delimiter);
+      }
+      else if (parse)
+      {
+        if (!(field = _LLLoadStage(loader, p, 0, No, column))) goto failed;
+        q = _LLLoadParse(p, end, delimiter ? delimiter : '\n', field);
+      }
+      else
+      {
+        if (delimiter) q = _LLLoadScan(p, end, delimiter);
+        else if (!(q = (const char *)memchr(p, '\n', (size_t)(end - p)))) q = end;
+
+        fieldLength = (size_t)(q - p);
+        if (fieldLength && p[fieldLength - 1] == '\r' && (q == end || *q == '\n')) fieldLength--;
+        if (!_LLLoadStage(loader, p, fieldLength, No, column)) goto failed;
+      }
+
+      if (q >= end)
+      {
+        if (!final) goto incomplete;
+        p = end;
+        break;
+      }
+
+      p = q + 1;
+      if (*q == '\n') break;
+    }
+
+    /* Blank lines produce nothing */
+    if (loader->count - mark == 1 && !loader->fields[mark].length && !loader->fields[mark].quoted)
+    {
+      loader->count = mark;
+    }
+    else if (loader->needHeader && !_LLLoadColumns(loader, mark)) goto failed;
+
+    if (loader->count >= LL_LOAD_BATCH && !_LLLoadFlush(loader)) goto failed;
+    continue;
+
+incomplete:
+    loader->count = mark;
+    return (size_t)(record - data);
+  }
+
+  return (size_t)(p - data);
+
+failed:
+  loader->failed = Yes;
+  return 0;
+}
+
+void _LLLoaderInit(LLLoader *loader, LinkList *list, const LLLoadOptions *options)
+{
+  memset(loader, 0L, sizeof(LLLoader));
+  loader->list = list;
+  if (options) loader->options = *options;
+  loader->needHeader = loader->options.header;
+}
+
+long _LLLoaderFinish(LLLoader *loader)
+{
+  if (!loader->failed && !_LLLoadFlush(loader)) loader->failed = Yes;
+
+  free(loader->fields);
+  free(loader->names);
+  free(loader->nameOffsets);
+  free(loader->keys);
+  return loader->failed ? -1 : loader->pushed;
+}
+
+/* Block reads for files that cannot be mapped; a record straddling two
+ * reads is moved to the front of the buffer and completed by the next */
+void _LLLoadStream(LLLoader *loader, FILE *file)
+{
+  size_t capacity = LL_LOAD_BUFFER, used = 0, read, consumed;
+  char *buffer = (char *)malloc(capacity), *grown;
+  LLBoolean final = No;
+
+  if (!buffer)
+  {
+    loader->failed = Yes;
+    return;
+  }
+
+  while (!final && !loader->failed)
+  {
+    read = fread(buffer + used, 1, capacity - used, file);
+    final = read == 0 ? Yes : No;
+    used += read;
+
+    consumed = _LLLoadRecords(loader, buffer, used, final);
+
+    /* Staged fields point into the buffer, so they go out before it moves */
+    if (!_LLLoadFlush(loader)) loader->failed = Yes;
+
+    memmove(buffer, buffer + consumed, used - consumed);
+    used -= consumed;
+
+    if (used == capacity)
+    {
+      grown = (char *)realloc(buffer, capacity << 1);
+      if (!grown) loader->failed = Yes;
+      else buffer = grown, capacity <<= 1;
+    }
+  }
+
+  if (ferror(file)) loader->failed = Yes;
+  free(buffer);
+}
+
+#pragma mark - Loading Functions
+
+long LLLoadBuffer(LinkList *list, const char *data, size_t length, const LLLoadOptions *options)
+{
+  LLLoader loader;
+
+  _LLLoaderInit(&loader, list, options);
+  _LLLoadRecords(&loader, data, length, Yes);
+  return _LLLoaderFinish(&loader);
+}
+
+long LLLoadFile(LinkList *list, const char *path, const LLLoadOptions *options)
+{
+  LLLoader loader;
+  FILE *file;
+  #ifdef LL_LOAD_MMAP
+  struct stat info;
+  void *mapping;
+  long pushed;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0) return -1;
+
+  if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+  {
+    if (info.st_size == 0)
+    {
+      close(fd);
+      return 0;
+    }
+
+    mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED)
+    {
+      close(fd);
+      #ifdef MADV_SEQUENTIAL
+      madvise(mapping, (size_t)info.st_size, MADV_SEQUENTIAL);
+      #endif
+
+      /* Finishing pushes the last staged fields, which point into the map */
+      _LLLoaderInit(&loader, list, options);
+      _LLLoadRecords(&loader, (const char *)mapping, (size_t)info.st_size, Yes);
+      pushed = _LLLoaderFinish(&loader);
+      munmap(mapping, (size_t)info.st_size);
+      return pushed;
+    }
+  }
+  close(fd);
+  #endif
+
+  file = fopen(path, "rb");
+  if (!file) return -1;
+
+  _LLLoaderInit(&loader, list, options);
+  _LLLoadStream(&loader, file);
+  fclose(file);
+  return _LLLoaderFinish(&loader);
+}
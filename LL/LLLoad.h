@@ -0,0 +1,52 @@
+#ifndef LL_LOAD_H
+#define LL_LOAD_H
+
+#include "LinkList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bulk loading of newline delimited and CSV text. Files are mapped where
+ * possible and otherwise read LL_LOAD_BUFFER bytes at a time. Records are
+ * split a machine word at a time and numbers take a strtol/strtod free
+ * fast path. Parsed fields are staged and pushed LL_LOAD_BATCH at a time
+ * out of a single LLNodeBlock, which also holds their keys and strings.
+ *
+ * CSV fields may be quoted, with "" standing for a literal quote; a
+ * trailing \r before each newline is dropped. Blank lines are skipped. */
+#ifndef LL_LOAD_BUFFER
+#define LL_LOAD_BUFFER (1 << 20)
+#endif
+
+#ifndef LL_LOAD_BATCH
+#define LL_LOAD_BATCH 4096
+#endif
+
+#pragma mark - Types
+
+typedef struct LLLoadOptions
+{
+  /** Field separator such as ',' or '\t'; 0 loads each line as one field */
+  char delimiter;
+
+  /** The first record names the columns and each field is keyed by its
+   * column's name; fields past the last named column are left unkeyed */
+  LLBoolean header;
+
+  /** Fields that read entirely as numbers become LLIN_LONG integer or
+   * LLDN_DOUBLE decimal nodes instead of strings */
+  LLBoolean numbers;
+} LLLoadOptions;
+
+#pragma mark - Loading Functions
+
+/* Both return the number of nodes pushed, or -1 if loading failed */
+long LLLoadBuffer(LinkList *list, const char *data, size_t length, const LLLoadOptions *options);
+long LLLoadFile(LinkList *list, const char *path, const LLLoadOptions *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,566 @@
+#include "LLSerialize.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LL_SERIAL_KEYED 0x80
+#define LL_SERIAL_INT_KEYED 0x40
+#define LL_SERIAL_END 0x00
+#define LL_SERIAL_UNSIGNED 0x80
+
+#pragma mark - Internal Helper Functions
+
+size_t LLFileWrite(const void *bytes, size_t length, LLVoid context)
+{
+  return fwrite(bytes, 1, length, (FILE *)context);
+}
+
+size_t LLFileRead(void *bytes, size_t length, LLVoid context)
+{
+  return fread(bytes, 1, length, (FILE *)context);
+}
+
+LLBoolean _LLLittleEndian(void)
+{
+  unsigned int one = 1;
+  return *(unsigned char *)&one ? Yes : No;
+}
+
+/* Copies an in-memory value out in little endian byte order */
+void _LLOrderBytes(unsigned char *dest, const void *source, size_t length)
+{
+  const unsigned char *bytes = (const unsigned char *)source;
+  size_t i;
+
+  if (_LLLittleEndian()) memcpy(dest, bytes, length);
+  else for (i = 0; i < length; i++) dest[i] = bytes[length - 1 - i];
+}
+
+#pragma mark - Primitive Functions
+
+void LLWriterAttach(LLWriter *writer, LLWriteFn write, LLVoid context)
+{
+  memset(writer, 0L, sizeof(LLWriter));
+  writer->write = write;
+  writer->context = context;
+}
+
+LLBoolean LLWriterFlush(LLWriter *writer)
+{
+  if (writer->used && !writer->failed)
+  {
+    if (writer->write(writer->buffer, writer->used, writer->context) != writer->used)
+    {
+      writer->failed = Yes;
+    }
+  }
+
+  writer->used = 0;
+  return writer->failed ? No : Yes;
+}
+
+void LLWriteBytes(LLWriter *writer, const void *bytes, size_t length)
+{
+  if (writer->used + length > LL_SERIAL_BUFFER) LLWriterFlush(writer);
+  if (writer->failed) return;
+
+  /* Anything bigger than the staging buffer goes straight to the sink */
+  if (length >= LL_SERIAL_BUFFER)
+  {
+    if (writer->write(bytes, length, writer->context) != length) writer->failed = Yes;
+    return;
+  }
+
+  memcpy(writer->buffer + writer->used, bytes, length);
+  writer->used += length;
+}
+
+void LLWriteByte(LLWriter *writer, unsigned char byte)
+{
+  LLWriteBytes(writer, &byte, 1);
+}
+
+void LLWriteVarint(LLWriter *writer, unsigned MAX_INT_TYPE value)
+{
+  unsigned char bytes[(sizeof(value) * 8 + 6) / 7];
+  size_t length = 0;
+
+  do
+  {
+    bytes[length] = (unsigned char)(value & 0x7f);
+    value >>= 7;
+    if (value) bytes[length] |= 0x80;
+    length++;
+  }
+  while (value);
+
+  LLWriteBytes(writer, bytes, length);
+}
+
+#pragma mark - Internal Record Functions
+
+/* Fails the writer on a length no reader would accept */
+LLBoolean _LLWriterLength(LLWriter *writer, size_t length)
+{
+  if (length > LL_SERIAL_MAX_LENGTH) writer->failed = Yes;
+  else LLWriteVarint(writer, (unsigned MAX_INT_TYPE)length);
+
+  return writer->failed ? No : Yes;
+}
+
+void _LLWriterKey(LLWriter *writer, LinkNode *node)
+{
+  LLKeyedNode *keyed = (LLKeyedNode *)node->value;
+  size_t length = strlen(keyed->key);
+
+  if (!_LLWriterLength(writer, length)) return;
+  LLWriteBytes(writer, keyed->key, length);
+}
+
+void _LLWriterIntKey(LLWriter *writer, LinkNode *node)
+{
+  LLIntKey key = ((LLIntKeyed *)node->value)->key;
+
+  LLWriteVarint(writer, ((unsigned MAX_INT_TYPE)key << 1) ^ (unsigned MAX_INT_TYPE)(key < 0 ? -1 : 0));
+}
+
+LLBoolean _LLReaderFill(LLReader *reader)
+{
+  if (reader->failed) return No;
+
+  reader->length = reader->read(reader->buffer, LL_SERIAL_BUFFER, reader->context);
+  reader->position = 0;
+  if (!reader->length) reader->failed = Yes;
+
+  return reader->failed ? No : Yes;
+}
+
+LLBoolean LLReadBytes(LLReader *reader, void *dest, size_t length)
+{
+  unsigned char *out = (unsigned char *)dest;
+  size_t chunk;
+
+  while (length)
+  {
+    if (reader->position == reader->length && !_LLReaderFill(reader)) return No;
+
+    chunk = reader->length - reader->position;
+    if (chunk > length) chunk = length;
+
+    memcpy(out, reader->buffer + reader->position, chunk);
+    reader->position += chunk;
+    out += chunk;
+    length -= chunk;
+  }
+
+  return Yes;
+}
+
+int LLReadByte(LLReader *reader)
+{
+  unsigned char byte;
+
+  return LLReadBytes(reader, &byte, 1) ? byte : -1;
+}
+
+unsigned MAX_INT_TYPE LLReadVarint(LLReader *reader)
+{
+  unsigned MAX_INT_TYPE value = 0;
+  unsigned int shift = 0;
+  int byte;
+
+  do
+  {
+    byte = LLReadByte(reader);
+    if (byte < 0 || shift >= sizeof(value) * 8)
+    {
+      reader->failed = Yes;
+      return 0;
+    }
+
+    value |= (unsigned MAX_INT_TYPE)(byte & 0x7f) << shift;
+    shift += 7;
+  }
+  while (byte & 0x80);
+
+  return value;
+}
+
+/* Reads a key or string length, failing the reader on one no writer
+ * would produce, so length + 1 terminated units are always allocatable */
+LLBoolean _LLReadLength(LLReader *reader, size_t *length)
+{
+  unsigned MAX_INT_TYPE value = LLReadVarint(reader);
+
+  if (reader->failed || value > LL_SERIAL_MAX_LENGTH
+    || value >= (size_t)-1 / sizeof(wchar_t))
+  {
+    reader->failed = Yes;
+    return No;
+  }
+
+  *length = (size_t)value;
+  return Yes;
+}
+
+char *_LLReaderScratch(LLReader *reader, size_t length)
+{
+  char *scratch;
+
+  if (length + 1 > reader->scratchSize)
+  {
+    scratch = (char *)realloc(reader->scratch, length + 1);
+    if (!scratch)
+    {
+      reader->failed = Yes;
+      return NULL;
+    }
+    reader->scratch = scratch;
+    reader->scratchSize = length + 1;
+  }
+
+  if (!LLReadBytes(reader, reader->scratch, length)) return NULL;
+
+  reader->scratch[length] = 0;
+  return reader->scratch;
+}
+
+/* Pushes a string node that takes ownership of an already read buffer;
+ * intKey is only consulted when isIntKeyed is set */
+LinkNode *_LLReaderPushString(LinkList *list, LLKey key, LLBoolean isIntKeyed, LLIntKey intKey,
+  LLVoid string, LLStringType type)
+{
+  LLKeyedNode *keyNode;
+  LLKeyedString *keyed;
+  LLIntKeyed *intKeyed;
+  LLStringNode *data;
+
+  if (isIntKeyed)
+  {
+    intKeyed = LNIKCreate(intKey);
+    intKeyed->u.s.u.s = (char *)string;
+    intKeyed->u.s.type = type;
+    return LLPush(list, LNCreate(intKeyed, LN_STRING | LN_INT_KEYED));
+  }
+
+  if (key)
+  {
+    keyNode = LNKCreate(key, LLDefaultHashFunction);
+    keyed = LNKSInit(NULL, Yes);
+    memcpy(&keyed->keyedNode, keyNode, sizeof(LLKeyedNode));
+    free(keyNode);
+
+    keyed->string.u.s = (char *)string;
+    keyed->string.type = type;
+    return LLPush(list, LNCreate(keyed, LN_STRING | LN_KEYED));
+  }
+
+  data = LNSInit(NULL, Yes);
+  data->u.s = (char *)string;
+  data->type = type;
+  return LLPush(list, LNCreate(data, LN_STRING));
+}
+
+#pragma mark - Writer Functions
+
+LLBoolean LLWriterInit(LLWriter *writer, LLWriteFn write, LLVoid context)
+{
+  LLWriterAttach(writer, write, context);
+  LLWriteBytes(writer, "LLB", 3);
+  LLWriteByte(writer, LL_SERIAL_VERSION);
+  return writer->failed ? No : Yes;
+}
+
+LLBoolean LLWriterInitFile(LLWriter *writer, FILE *file)
+{
+  return LLWriterInit(writer, LLFileWrite, file);
+}
+
+LLBoolean LLWriteNode(LLWriter *writer, LinkNode *node)
+{
+  LLBoolean isKeyed = node->type & LN_KEYED ? Yes : No;
+  LLBoolean isIntKeyed = node->type & LN_INT_KEYED ? Yes : No;
+  int unkeyedType = node->type & LN_TYPE_MASK;
+  LLIntegerNode *intNode;
+  LLDecimalNode *decNode;
+  LLStringNode *strNode;
+  unsigned MAX_INT_TYPE bits;
+  MAX_INT_TYPE value;
+  unsigned char bytes[8];
+  float f;
+  double d;
+  size_t length;
+  #ifdef WCHAR_SUPPORT
+  size_t i;
+  #endif
+
+  if (writer->failed) return No;
+  if (!node->value || unkeyedType == LN_USER || unkeyedType == LN_VOID) return Yes;
+
+  LLWriteByte(writer, (unsigned char)(unkeyedType | (isKeyed ? LL_SERIAL_KEYED : 0)
+    | (isIntKeyed ? LL_SERIAL_INT_KEYED : 0)));
+  if (isKeyed) _LLWriterKey(writer, node);
+  if (isIntKeyed) _LLWriterIntKey(writer, node);
+
+  switch (unkeyedType)
+  {
+    case LN_BOOLEAN:
+      LLWriteByte(writer, (isKeyed
+        ? ((LLKeyedBool *)node->value)->boolean
+        : ((LLBoolNode *)node->value)->boolean) ? 1 : 0);
+      break;
+
+    case LN_INTEGER:
+      intNode = isKeyed ? &((LLKeyedInteger *)node->value)->integer : (LLIntegerNode *)node->value;
+      value = LLIntegerValue(intNode);
+
+      if (intNode->type & LLIN_UNSIGNED)
+      {
+        LLWriteByte(writer, (unsigned char)((intNode->type & 0x7f) | LL_SERIAL_UNSIGNED));
+        LLWriteVarint(writer, (unsigned MAX_INT_TYPE)value);
+      }
+      else
+      {
+        /* Zigzag keeps small negative numbers to a byte or two */
+        bits = ((unsigned MAX_INT_TYPE)value << 1) ^ (unsigned MAX_INT_TYPE)(value < 0 ? -1 : 0);
+        LLWriteByte(writer, (unsigned char)(intNode->type & 0x7f));
+        LLWriteVarint(writer, bits);
+      }
+      break;
+
+    case LN_DECIMAL:
+      decNode = isKeyed ? &((LLKeyedDecimal *)node->value)->decimal : (LLDecimalNode *)node->value;
+      LLWriteByte(writer, (unsigned char)decNode->type);
+
+      if (decNode->type == LLDN_FLOAT)
+      {
+        f = decNode->u.f;
+        _LLOrderBytes(bytes, &f, sizeof(f));
+        LLWriteBytes(writer, bytes, 4);
+      }
+      else
+      {
+        /* Long doubles have no portable layout and travel as doubles */
+        d = (double)LLDecimalValue(decNode);
+        _LLOrderBytes(bytes, &d, sizeof(d));
+        LLWriteBytes(writer, bytes, 8);
+      }
+      break;
+
+    case LN_STRING:
+      strNode = isKeyed ? &((LLKeyedString *)node->value)->string : (LLStringNode *)node->value;
+      LLWriteByte(writer, (unsigned char)strNode->type);
+
+      #ifdef WCHAR_SUPPORT
+      if (strNode->type == LLSN_WIDE)
+      {
+        length = wcslen(strNode->u.w);
+        if (!_LLWriterLength(writer, length)) break;
+        for (i = 0; i < length; i++) LLWriteVarint(writer, (unsigned MAX_INT_TYPE)strNode->u.w[i]);
+        break;
+      }
+      #endif
+
+      length = strlen(strNode->u.s);
+      if (!_LLWriterLength(writer, length)) break;
+      LLWriteBytes(writer, strNode->u.s, length);
+      break;
+  }
+
+  if (!writer->failed) writer->nodes++;
+  return writer->failed ? No : Yes;
+}
+
+LLBoolean LLWriteList(LLWriter *writer, LinkList *list)
+{
+  LinkNode *node;
+
+  for (node = list->head; node && !writer->failed; node = node->next)
+  {
+    LLWriteNode(writer, node);
+  }
+
+  return writer->failed ? No : Yes;
+}
+
+LLBoolean LLWriterFinish(LLWriter *writer)
+{
+  LLWriteByte(writer, LL_SERIAL_END);
+  return LLWriterFlush(writer);
+}
+
+#pragma mark - Reader Functions
+
+LLBoolean LLReaderInit(LLReader *reader, LLReadFn read, LLVoid context)
+{
+  unsigned char header[4];
+
+  memset(reader, 0L, sizeof(LLReader));
+  reader->read = read;
+  reader->context = context;
+
+  if (!LLReadBytes(reader, header, 4) || memcmp(header, "LLB", 3) != 0
+    || header[3] > LL_SERIAL_VERSION)
+  {
+    reader->failed = Yes;
+    return No;
+  }
+
+  reader->version = header[3];
+  return Yes;
+}
+
+LLBoolean LLReaderInitFile(LLReader *reader, FILE *file)
+{
+  return LLReaderInit(reader, LLFileRead, file);
+}
+
+LinkNode *LLReadNode(LLReader *reader, LinkList *list)
+{
+  int tag = LLReadByte(reader), subtype;
+  LLBoolean isKeyed, isIntKeyed;
+  LLKey key = NULL;
+  LLIntKey intKey = 0;
+  unsigned MAX_INT_TYPE bits;
+  MAX_INT_TYPE value;
+  unsigned char bytes[8];
+  float f;
+  double d;
+  size_t length;
+  char *string;
+  #ifdef WCHAR_SUPPORT
+  wchar_t *wide;
+  size_t i;
+  #endif
+
+  if (tag < 0 || reader->finished) return NULL;
+  if (tag == LL_SERIAL_END)
+  {
+    reader->finished = Yes;
+    return NULL;
+  }
+
+  isKeyed = tag & LL_SERIAL_KEYED ? Yes : No;
+  isIntKeyed = tag & LL_SERIAL_INT_KEYED ? Yes : No;
+  tag &= ~(LL_SERIAL_KEYED | LL_SERIAL_INT_KEYED);
+
+  if (isKeyed && isIntKeyed)
+  {
+    reader->failed = Yes;
+    return NULL;
+  }
+
+  if (isKeyed)
+  {
+    if (!_LLReadLength(reader, &length) || !(key = _LLReaderScratch(reader, length))) return NULL;
+  }
+
+  if (isIntKeyed)
+  {
+    bits = LLReadVarint(reader);
+    if (reader->failed) return NULL;
+    intKey = (LLIntKey)(bits >> 1) ^ -(LLIntKey)(bits & 1);
+  }
+
+  /* Every payload opens with a byte: a boolean's value or a subtype */
+  if ((subtype = LLReadByte(reader)) < 0) return NULL;
+
+  switch (tag)
+  {
+    case LN_BOOLEAN:
+      reader->nodes++;
+      if (isIntKeyed) return LLPushIntKeyedBoolean(list, intKey, subtype ? Yes : No);
+      return key
+        ? LLPushKeyedBoolean(list, key, subtype ? Yes : No)
+        : LLPushBoolean(list, subtype ? Yes : No);
+
+    case LN_INTEGER:
+      bits = LLReadVarint(reader);
+      if (reader->failed) return NULL;
+
+      if (subtype & LL_SERIAL_UNSIGNED) value = (MAX_INT_TYPE)bits;
+      else value = (MAX_INT_TYPE)(bits >> 1) ^ -(MAX_INT_TYPE)(bits & 1);
+
+      subtype = (subtype & 0x7f) | (subtype & LL_SERIAL_UNSIGNED ? LLIN_UNSIGNED : 0);
+      reader->nodes++;
+      if (isIntKeyed) return LLPushIntKeyedInteger(list, intKey, value, (LLIntegerType)subtype);
+      return key
+        ? LLPushKeyedInteger(list, key, value, (LLIntegerType)subtype)
+        : LLPushInteger(list, value, (LLIntegerType)subtype);
+
+    case LN_DECIMAL:
+      if (subtype == LLDN_FLOAT)
+      {
+        if (!LLReadBytes(reader, bytes, 4)) return NULL;
+        _LLOrderBytes((unsigned char *)&f, bytes, sizeof(f));
+        d = f;
+      }
+      else
+      {
+        if (!LLReadBytes(reader, bytes, 8)) return NULL;
+        _LLOrderBytes((unsigned char *)&d, bytes, sizeof(d));
+      }
+
+      reader->nodes++;
+      if (isIntKeyed) return LLPushIntKeyedDecimal(list, intKey, d, (LLDecimalType)subtype);
+      return key
+        ? LLPushKeyedDecimal(list, key, d, (LLDecimalType)subtype)
+        : LLPushDecimal(list, d, (LLDecimalType)subtype);
+
+    case LN_STRING:
+      if (!_LLReadLength(reader, &length)) return NULL;
+
+      #ifdef WCHAR_SUPPORT
+      if (subtype == LLSN_WIDE)
+      {
+        wide = (wchar_t *)malloc((length + 1) * sizeof(wchar_t));
+        if (!wide)
+        {
+          reader->failed = Yes;
+          return NULL;
+        }
+        for (i = 0; i < length; i++) wide[i] = (wchar_t)LLReadVarint(reader);
+        wide[length] = 0;
+
+        if (reader->failed)
+        {
+          free(wide);
+          return NULL;
+        }
+        reader->nodes++;
+        return _LLReaderPushString(list, key, isIntKeyed, intKey, wide, LLSN_WIDE);
+      }
+      #endif
+
+      /* Strings are read once, straight into the buffer the node will own */
+      string = (char *)malloc(length + 1);
+      if (!string || !LLReadBytes(reader, string, length))
+      {
+        free(string);
+        reader->failed = Yes;
+        return NULL;
+      }
+      string[length] = 0;
+
+      reader->nodes++;
+      return _LLReaderPushString(list, key, isIntKeyed, intKey, string, LLSN_STRING);
+  }
+
+  reader->failed = Yes;
+  return NULL;
+}
+
+size_t LLReadList(LLReader *reader, LinkList *list)
+{
+  size_t count = 0;
+
+  while (LLReadNode(reader, list)) count++;
+  return count;
+}
+
+void LLReaderFinish(LLReader *reader)
+{
+  free(reader->scratch);
+  reader->scratch = NULL;
+  reader->scratchSize = 0;
+}
@@ -0,0 +1,109 @@
+#ifndef LL_SERIALIZE_H
+#define LL_SERIALIZE_H
+
+#include "LinkList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stream layout, version 2:
+ *
+ *   "LLB" version
+ *   record*  tag [keyLen key] [intKey] payload
+ *   0x00
+ *
+ * The tag holds the LinkNodeDataType in its low bits with 0x80 set for
+ * keyed nodes and 0x40 for LN_INT_KEYED ones, whose key is a zigzag
+ * varint. Lengths are unsigned LEB128 varints. Version 1 streams, which
+ * never set 0x40, are still read. Payloads are:
+ *
+ *   boolean  one byte
+ *   integer  subtype (width | 0x80 if unsigned), zigzag or plain varint
+ *   decimal  subtype, little endian IEEE float or double
+ *   string   subtype, varint length then bytes (wide: varint code units)
+ *
+ * Void and user nodes hold process local pointers and are not written. */
+#define LL_SERIAL_VERSION 2
+
+/** Longest key or string, in bytes or wide code units, a stream may hold.
+ * Readers reject longer lengths before allocating and writers refuse them,
+ * so a corrupt or torn stream cannot request an arbitrary allocation. */
+#ifndef LL_SERIAL_MAX_LENGTH
+#define LL_SERIAL_MAX_LENGTH (1UL << 28)
+#endif
+
+/** Size of the fixed staging buffer inside each writer and reader */
+#ifndef LL_SERIAL_BUFFER
+#define LL_SERIAL_BUFFER 4096
+#endif
+
+#pragma mark - Types
+
+/** Sink for serialized bytes; returns the number of bytes accepted */
+typedef size_t (*LLWriteFn)(const void *bytes, size_t length, LLVoid context);
+
+/** Source of serialized bytes; returns bytes read, 0 at end of input */
+typedef size_t (*LLReadFn)(void *bytes, size_t length, LLVoid context);
+
+typedef struct LLWriter
+{
+  LLWriteFn write;
+  LLVoid context;
+  unsigned char buffer[LL_SERIAL_BUFFER];
+  size_t used;
+  unsigned long nodes;
+  LLBoolean failed;
+} LLWriter;
+
+typedef struct LLReader
+{
+  LLReadFn read;
+  LLVoid context;
+  unsigned char buffer[LL_SERIAL_BUFFER];
+  size_t position;
+  size_t length;
+  char *scratch;
+  size_t scratchSize;
+  unsigned long nodes;
+  int version;
+  LLBoolean failed;
+  LLBoolean finished;
+} LLReader;
+
+#pragma mark - Primitive Functions
+
+/* Building blocks for formats layered on this one, such as LLJournal.
+ * LLWriterAttach binds a sink without writing the stream header. */
+void LLWriterAttach(LLWriter *writer, LLWriteFn write, LLVoid context);
+size_t LLFileWrite(const void *bytes, size_t length, LLVoid context);
+size_t LLFileRead(void *bytes, size_t length, LLVoid context);
+LLBoolean LLWriterFlush(LLWriter *writer);
+void LLWriteBytes(LLWriter *writer, const void *bytes, size_t length);
+void LLWriteByte(LLWriter *writer, unsigned char byte);
+void LLWriteVarint(LLWriter *writer, unsigned MAX_INT_TYPE value);
+LLBoolean LLReadBytes(LLReader *reader, void *dest, size_t length);
+int LLReadByte(LLReader *reader);
+unsigned MAX_INT_TYPE LLReadVarint(LLReader *reader);
+
+#pragma mark - Writer Functions
+
+LLBoolean LLWriterInit(LLWriter *writer, LLWriteFn write, LLVoid context);
+LLBoolean LLWriterInitFile(LLWriter *writer, FILE *file);
+LLBoolean LLWriteNode(LLWriter *writer, LinkNode *node);
+LLBoolean LLWriteList(LLWriter *writer, LinkList *list);
+LLBoolean LLWriterFinish(LLWriter *writer);
+
+#pragma mark - Reader Functions
+
+LLBoolean LLReaderInit(LLReader *reader, LLReadFn read, LLVoid context);
+LLBoolean LLReaderInitFile(LLReader *reader, FILE *file);
+LinkNode *LLReadNode(LLReader *reader, LinkList *list);
+size_t LLReadList(LLReader *reader, LinkList *list);
+void LLReaderFinish(LLReader *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
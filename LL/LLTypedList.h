@@ -0,0 +1,131 @@
+#ifndef LL_TYPED_LIST_H
+#define LL_TYPED_LIST_H
+
+#include <stdlib.h>
+
+#include "LinkList.h"
+
+/* Preprocessor generated lists holding one C type. Every node stores its
+ * value inline, so there is no data type tag, no value pointer and a
+ * single allocation per element. LL_DEFINE_LIST(LLDouble, double) yields
+ *
+ *   LLDoubleNode, LLDoubleList, LLDoubleForEachFn and
+ *   LLDoubleListCreate, LLDoubleListDelete, LLDoubleListPush,
+ *   LLDoubleListPop, LLDoubleListDequeue, LLDoubleListFind,
+ *   LLDoubleListRemove and LLDoubleListForEach
+ *
+ * as static functions in the including file. Find compares values with ==;
+ * struct types and any other notion of equality go through
+ * LL_DEFINE_LIST_EQ, whose equals(a, b) may be a function or a macro.
+ * The expansion is plain C89 and holds no pointers into LinkList itself. */
+
+#if defined(__GNUC__)
+#define LL_TYPED_UNUSED __attribute__((unused))
+#else
+#define LL_TYPED_UNUSED
+#endif
+
+#define LL_TYPED_EQUALS(a, b) ((a) == (b))
+
+#define LL_DEFINE_LIST(name, type) LL_DEFINE_LIST_EQ(name, type, LL_TYPED_EQUALS)
+
+#define LL_DEFINE_LIST_EQ(name, type, equals) \
+  typedef struct name##Node \
+  { \
+    struct name##Node *next; \
+    struct name##Node *prev; \
+    type value; \
+  } name##Node; \
+  \
+  typedef struct name##List \
+  { \
+    name##Node *head; \
+    name##Node *tail; \
+    unsigned long length; \
+  } name##List; \
+  \
+  typedef void (*name##ForEachFn)(type *value, size_t index, name##List *list); \
+  \
+  static LL_TYPED_UNUSED name##List *name##ListCreate(void) \
+  { \
+    name##List *list = (name##List *)malloc(sizeof(name##List)); \
+    if (!list) return NULL; \
+    list->head = NULL; \
+    list->tail = NULL; \
+    list->length = 0; \
+    return list; \
+  } \
+  \
+  static LL_TYPED_UNUSED void name##ListDelete(name##List *list) \
+  { \
+    name##Node *node, *next; \
+    if (!list) return; \
+    for (node = list->head; node; node = next) \
+    { \
+      next = node->next; \
+      free(node); \
+    } \
+    free(list); \
+  } \
+  \
+  static LL_TYPED_UNUSED name##Node *name##ListPush(name##List *list, type value) \
+  { \
+    name##Node *node = (name##Node *)malloc(sizeof(name##Node)); \
+    if (!node) return NULL; \
+    node->value = value; \
+    node->next = NULL; \
+    node->prev = list->tail; \
+    if (list->tail) list->tail->next = node; \
+    else list->head = node; \
+    list->tail = node; \
+    list->length++; \
+    return node; \
+  } \
+  \
+  /* Unlinks and frees node, which must belong to list */ \
+  static LL_TYPED_UNUSED void name##ListRemove(name##List *list, name##Node *node) \
+  { \
+    if (!node) return; \
+    if (node->prev) node->prev->next = node->next; \
+    else list->head = node->next; \
+    if (node->next) node->next->prev = node->prev; \
+    else list->tail = node->prev; \
+    list->length--; \
+    free(node); \
+  } \
+  \
+  static LL_TYPED_UNUSED LLBoolean name##ListPop(name##List *list, type *value) \
+  { \
+    if (!list->tail) return No; \
+    if (value) *value = list->tail->value; \
+    name##ListRemove(list, list->tail); \
+    return Yes; \
+  } \
+  \
+  static LL_TYPED_UNUSED LLBoolean name##ListDequeue(name##List *list, type *value) \
+  { \
+    if (!list->head) return No; \
+    if (value) *value = list->head->value; \
+    name##ListRemove(list, list->head); \
+    return Yes; \
+  } \
+  \
+  /* Returns the earliest pushed node holding value, or NULL */ \
+  static LL_TYPED_UNUSED name##Node *name##ListFind(name##List *list, type value) \
+  { \
+    name##Node *node; \
+    for (node = list->head; node; node = node->next) \
+    { \
+      if (equals(node->value, value)) return node; \
+    } \
+    return NULL; \
+  } \
+  \
+  static LL_TYPED_UNUSED void name##ListForEach(name##List *list, name##ForEachFn fn) \
+  { \
+    name##Node *node; \
+    size_t index = 0; \
+    for (node = list->head; node; node = node->next) fn(&node->value, index++, list); \
+  }
+
+#endif
@@ -0,0 +1,229 @@
+#include "LLWheel.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LL_WHEEL_MASK (LL_WHEEL_SLOTS - 1)
+
+#pragma mark - Internal Helper Functions
+
+void _LLWheelLink(LLWheel *wheel, LLTimerNode *timer)
+{
+  unsigned long delta = timer->deadline - wheel->now;
+  unsigned long deadline = timer->deadline;
+  LLTimerNode **slot;
+  int level = 0;
+
+  /* Cascades can land a timer due this very tick; it fires from slot now */
+  if (timer->deadline < wheel->now) delta = 0, deadline = wheel->now;
+
+  /* Find the first level whose span reaches the deadline */
+  while (level < LL_WHEEL_LEVELS - 1 && delta >= 1UL << ((level + 1) * LL_WHEEL_BITS)) level++;
+
+  /* Past the top level's span; park at its far edge and cascade later */
+  if (delta >= 1UL << (LL_WHEEL_LEVELS * LL_WHEEL_BITS))
+  {
+    deadline = wheel->now + (1UL << (LL_WHEEL_LEVELS * LL_WHEEL_BITS)) - 1;
+  }
+
+  timer->level = level;
+  timer->slot = (int)((deadline >> (level * LL_WHEEL_BITS)) & LL_WHEEL_MASK);
+
+  slot = &wheel->slots[level][timer->slot];
+  timer->prev = NULL;
+  timer->next = *slot;
+  if (*slot) (*slot)->prev = timer;
+  *slot = timer;
+
+  wheel->levelCounts[level]++;
+}
+
+void _LLWheelUnlink(LLWheel *wheel, LLTimerNode *timer)
+{
+  if (timer->prev) timer->prev->next = timer->next;
+  else wheel->slots[timer->level][timer->slot] = timer->next;
+  if (timer->next) timer->next->prev = timer->prev;
+
+  timer->next = NULL;
+  timer->prev = NULL;
+  wheel->levelCounts[timer->level]--;
+}
+
+void _LLWheelCascade(LLWheel *wheel, int level)
+{
+  int index = (int)((wheel->now >> (level * LL_WHEEL_BITS)) & LL_WHEEL_MASK);
+  LLTimerNode *timer = wheel->slots[level][index], *next;
+
+  wheel->slots[level][index] = NULL;
+  for (; timer; timer = next)
+  {
+    next = timer->next;
+    wheel->levelCounts[level]--;
+    _LLWheelLink(wheel, timer);
+  }
+}
+
+size_t _LLWheelExpireSlot(LLWheel *wheel)
+{
+  LLTimerNode **slot = &wheel->slots[0][wheel->now & LL_WHEEL_MASK];
+  LLTimerNode *timer;
+  size_t expired = 0;
+
+  while ((timer = *slot) != NULL)
+  {
+    _LLWheelUnlink(wheel, timer);
+    LLRemoveNode(wheel->list, &timer->link);
+    wheel->count--;
+    expired++;
+
+    if (wheel->onExpire) wheel->onExpire(&timer->link, wheel->context);
+    LNDelete(&timer->link);
+  }
+
+  return expired;
+}
+
+LinkNode *_LLWheelPush(LLWheel *wheel, LLVoid value, LinkNodeDataType type, unsigned long ttl)
+{
+  LLTimerNode *timer;
+
+  if (!value) return NULL;
+
+  timer = (LLTimerNode *)malloc(sizeof(LLTimerNode));
+  if (!timer)
+  {
+    LNDelete(LNCreate(value, type));
+    return NULL;
+  }
+
+  memset(timer, 0L, sizeof(LLTimerNode));
+  timer->link.value = value;
+  timer->link.type = type;
+  timer->deadline = wheel->now + (ttl ? ttl : 1);
+
+  LLPush(wheel->list, &timer->link);
+  _LLWheelLink(wheel, timer);
+  wheel->count++;
+  return &timer->link;
+}
+
+#pragma mark - Creation Functions
+
+LLWheel *LLWheelCreate(unsigned long now, LLExpireFn onExpire, LLVoid context)
+{
+  LLWheel *wheel = (LLWheel *)malloc(sizeof(LLWheel));
+
+  if (!wheel) return NULL;
+  memset(wheel, 0L, sizeof(LLWheel));
+
+  wheel->list = LLCreate();
+  if (!wheel->list || !LLEnableKeyIndex(wheel->list, Yes))
+  {
+    if (wheel->list) LLDelete(wheel->list);
+    free(wheel);
+    return NULL;
+  }
+
+  wheel->now = now;
+  wheel->onExpire = onExpire;
+  wheel->context = context;
+  return wheel;
+}
+
+#pragma mark - Deallocation Functions
+
+void LLWheelDelete(LLWheel *wheel)
+{
+  if (!wheel) return;
+
+  /* Every list node is an LLTimerNode whose link is its first member */
+  LLDelete(wheel->list);
+  free(wheel);
+}
+
+#pragma mark - Wheel Push Functions
+
+LinkNode *LLWheelPushKeyedBoolean(LLWheel *wheel, LLKey key, LLBoolean boolean, unsigned long ttl)
+{
+  return _LLWheelPush(wheel, LNKBCreate(key, boolean), LN_BOOLEAN | LN_KEYED, ttl);
+}
+
+LinkNode *LLWheelPushKeyedInteger(LLWheel *wheel, LLKey key, MAX_INT_TYPE value, LLIntegerType type, unsigned long ttl)
+{
+  return _LLWheelPush(wheel, LNKICreate(key, value, type), LN_INTEGER | LN_KEYED, ttl);
+}
+
+LinkNode *LLWheelPushKeyedDecimal(LLWheel *wheel, LLKey key, MAX_DEC_TYPE value, LLDecimalType type, unsigned long ttl)
+{
+  return _LLWheelPush(wheel, LNKDCreate(key, value, type), LN_DECIMAL | LN_KEYED, ttl);
+}
+
+LinkNode *LLWheelPushKeyedString(LLWheel *wheel, LLKey key, LLVoid string, LLStringType type, unsigned long ttl)
+{
+  return _LLWheelPush(wheel, LNKSCreate(key, string, type), LN_STRING | LN_KEYED, ttl);
+}
+
+LinkNode *LLWheelPushKeyedVoid(LLWheel *wheel, LLKey key, LLVoid data, unsigned long ttl)
+{
+  return _LLWheelPush(wheel, LNKVCreate(key, data), LN_VOID | LN_KEYED, ttl);
+}
+
+#pragma mark - Wheel Timer Functions
+
+LLBoolean LLWheelTouch(LLWheel *wheel, LLKey key, unsigned long ttl)
+{
+  LLTimerNode *timer = (LLTimerNode *)LLFindKeyed(wheel->list, key);
+
+  if (!timer) return No;
+
+  _LLWheelUnlink(wheel, timer);
+  timer->deadline = wheel->now + (ttl ? ttl : 1);
+  _LLWheelLink(wheel, timer);
+  return Yes;
+}
+
+LLBoolean LLWheelRemove(LLWheel *wheel, LLKey key)
+{
+  LLTimerNode *timer = (LLTimerNode *)LLFindKeyed(wheel->list, key);
+
+  if (!timer) return No;
+
+  _LLWheelUnlink(wheel, timer);
+  LLRemoveNode(wheel->list, &timer->link);
+  LNDelete(&timer->link);
+  wheel->count--;
+  return Yes;
+}
+
+size_t LLWheelAdvance(LLWheel *wheel, unsigned long now)
+{
+  size_t expired = 0;
+  int level;
+
+  while (wheel->now < now)
+  {
+    if (!wheel->count)
+    {
+      wheel->now = now;
+      break;
+    }
+
+    /* Nothing can fire before the next level 0 wrap; skip straight to it */
+    if (!wheel->levelCounts[0] && (wheel->now | LL_WHEEL_MASK) < now)
+    {
+      wheel->now |= LL_WHEEL_MASK;
+    }
+
+    wheel->now++;
+
+    for (level = 1; level < LL_WHEEL_LEVELS; level++)
+    {
+      if ((wheel->now >> ((level - 1) * LL_WHEEL_BITS)) & LL_WHEEL_MASK) break;
+      _LLWheelCascade(wheel, level);
+    }
+
+    expired += _LLWheelExpireSlot(wheel);
+  }
+
+  return expired;
+}
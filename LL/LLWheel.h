@@ -0,0 +1,74 @@
+#ifndef LL_WHEEL_H
+#define LL_WHEEL_H
+
+#include "LinkList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Four levels of 64 slots cover 2^24 ticks directly; longer TTLs park in
+ * the top level and are cascaded down again as time approaches them. */
+#define LL_WHEEL_BITS 6
+#define LL_WHEEL_SLOTS (1 << LL_WHEEL_BITS)
+#define LL_WHEEL_LEVELS 4
+
+#pragma mark - Types
+
+/** Invoked with each expired node after it leaves the list, before LNDelete */
+typedef void (*LLExpireFn)(LinkNode *node, LLVoid context);
+
+/** A keyed list node with a deadline. The LinkNode comes first so nodes
+ * found on wheel->list can be treated as timers and vice versa. */
+typedef struct LLTimerNode
+{
+  LinkNode link;
+  struct LLTimerNode *next;
+  struct LLTimerNode *prev;
+  unsigned long deadline;
+  int level;
+  int slot;
+} LLTimerNode;
+
+/** Hierarchical timing wheel over a keyed, key indexed LinkList. Time is
+ * whatever unit the caller advances it in and only moves on LLWheelAdvance.
+ * Entries must leave the list through LLWheelRemove or by expiring. */
+typedef struct LLWheel
+{
+  LinkList *list;
+  LLTimerNode *slots[LL_WHEEL_LEVELS][LL_WHEEL_SLOTS];
+  size_t levelCounts[LL_WHEEL_LEVELS];
+  size_t count;
+  unsigned long now;
+
+  LLExpireFn onExpire;
+  LLVoid context;
+} LLWheel;
+
+#pragma mark - Creation Functions
+
+LLWheel *LLWheelCreate(unsigned long now, LLExpireFn onExpire, LLVoid context);
+
+#pragma mark - Deallocation Functions
+
+void LLWheelDelete(LLWheel *wheel);
+
+#pragma mark - Wheel Push Functions
+
+LinkNode *LLWheelPushKeyedBoolean(LLWheel *wheel, LLKey key, LLBoolean boolean, unsigned long ttl);
+LinkNode *LLWheelPushKeyedInteger(LLWheel *wheel, LLKey key, MAX_INT_TYPE value, LLIntegerType type, unsigned long ttl);
+LinkNode *LLWheelPushKeyedDecimal(LLWheel *wheel, LLKey key, MAX_DEC_TYPE value, LLDecimalType type, unsigned long ttl);
+LinkNode *LLWheelPushKeyedString(LLWheel *wheel, LLKey key, LLVoid string, LLStringType type, unsigned long ttl);
+LinkNode *LLWheelPushKeyedVoid(LLWheel *wheel, LLKey key, LLVoid data, unsigned long ttl);
+
+#pragma mark - Wheel Timer Functions
+
+LLBoolean LLWheelTouch(LLWheel *wheel, LLKey key, unsigned long ttl);
+LLBoolean LLWheelRemove(LLWheel *wheel, LLKey key);
+size_t LLWheelAdvance(LLWheel *wheel, unsigned long now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,6 +3,36 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* Counter updates, and the arguments they would evaluate, vanish entirely
+ * without LL_STATS. Negative amounts wrap, decrementing the counter. */
+#ifdef LL_STATS
+#ifdef LL_STATS_ATOMIC
+#define LL_STAT_ADD(list, field, amount) \
+  __atomic_fetch_add(&(list)->stats.field, (unsigned long)(amount), __ATOMIC_RELAXED)
+#else
+#define LL_STAT_ADD(list, field, amount) ((list)->stats.field += (unsigned long)(amount))
+#endif
+#else
+#define LL_STAT_ADD(list, field, amount) ((void)0)
+#endif
+
+#ifdef LL_USDT
+#include <sys/sdt.h>
+#define LL_PROBE(name, op, list, type, key) DTRACE_PROBE4(clinklist, name, op, list, type, key)
+#else
+#define LL_PROBE(name, op, list, type, key) ((void)0)
+#endif
+
+/* The hook check is one load and branch while tracing is off */
+#define LL_TRACE_BEGIN(op, list, type, key) \
+  (LL_PROBE(op_begin, op, list, type, key), _LLTraceBegin ? _LLTraceSample(op, list, type, key) : No)
+#define LL_TRACE_END(traced, op, list, type, key) \
+  do { LL_PROBE(op_end, op, list, type, key); if (traced) _LLTraceReport(op, list, type, key); } while (0)
+
+extern LLTraceFn _LLTraceBegin;
+LLBoolean _LLTraceSample(LLTraceOp op, LinkList *list, int type, LLKey key);
+void _LLTraceReport(LLTraceOp op, LinkList *list, int type, LLKey key);
+
 #pragma mark - Internal Helper Functions
 
 unsigned int LLDefaultStringHashFn(LLKey key, int limit)
@@ -19,6 +49,32 @@ unsigned int LLDefaultStringHashFn(LLKey key, int limit)
   return result;
 }
 
+/* LLKeyHash that also measures key, so a lookup reads it only once */
+unsigned long _LLKeyHashLength(LLKey key, size_t *length)
+{
+  unsigned long hash = 2166136261UL;
+  unsigned char c;
+  LLKey start = key;
+
+  /* 32-bit FNV-1a over ASCII folded bytes, so keys differing only in case
+   * share a hash in either comparison mode */
+  while ((c = (unsigned char)*key++) != 0)
+  {
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    hash ^= c;
+    hash = (hash * 16777619UL) & 0xffffffffUL;
+  }
+
+  *length = (size_t)(key - start - 1);
+  return hash;
+}
+
+unsigned long LLKeyHash(LLKey key)
+{
+  size_t length;
+  return _LLKeyHashLength(key, &length);
+}
+
 #ifndef LL_DEFAULT_HASHFN
 #define LL_DEFAULT_HASHFN
 const LLHashFn LLDefaultHashFunction = LLDefaultStringHashFn;
@@ -57,7 +113,7 @@ wchar_t *__wstrdup(wchar_t *source)
 
 void LNSetIntByType(LLIntegerNode *node, LLIntegerType type, MAX_INT_TYPE value)
 {  
-  switch(type) 
+  switch(type & ~LLIN_UNSIGNED) 
   {
     case LLIN_CHAR:
       type & LLIN_UNSIGNED 
@@ -141,13 +197,215 @@ void LNSetStrByType(LLStringNode *node, LLStringType type, LLVoid string)
   }
 }
 
+LLKeyedNode *_LLNodeKeyed(LinkNode *node)
+{
+  return node->type & LN_KEYED ? (LLKeyedNode *)node->value : NULL;
+}
+
+/* Lowers the ASCII capitals in a word of bytes at once. Bytes above 0x7f
+ * are left alone, and no byte can carry into its neighbour. */
+unsigned long _LLFoldWord(unsigned long word)
+{
+  unsigned long ones = ~0UL / 255, low = word & ones * 0x7f;
+  unsigned long capitals = ~word & (low + ones * (0x80 - 'A')) & ~(low + ones * (0x7f - 'Z'));
+
+  return word | (capitals & ones * 0x80) >> 2;
+}
+
+/* Compares length bytes of a and b ignoring ASCII case */
+LLBoolean _LLKeyFoldEquals(const char *a, const char *b, size_t length)
+{
+  unsigned long x, y;
+
+  /* Short keys go a byte at a time */
+  if (length < sizeof(x))
+  {
+    for (; length; length--)
+    {
+      if (_LLFoldWord((unsigned char)*a++) != _LLFoldWord((unsigned char)*b++)) return No;
+    }
+    return Yes;
+  }
+
+  /* Longer ones a word at a time, the last word overlapping the one before
+   * it rather than leaving bytes over */
+  for (;;)
+  {
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    if (x != y && _LLFoldWord(x) != _LLFoldWord(y)) return No;
+    if (length == sizeof(x)) return Yes;
+
+    length -= sizeof(x);
+    if (length < sizeof(x))
+    {
+      a -= sizeof(x) - length;
+      b -= sizeof(x) - length;
+      length = sizeof(x);
+    }
+    a += sizeof(x);
+    b += sizeof(x);
+  }
+}
+
+/* Compares key, of the given length, with a node whose stored hash has
+ * already matched; ASCII case is ignored unless the list says otherwise */
+LLBoolean _LLKeyEquals(LinkList *list, LLKeyedNode *keyed, LLKey key, size_t length)
+{
+  if (keyed->keyLength != length) return No;
+  LL_STAT_ADD(list, keyCompares, 1);
+  if (list->caseSensitiveKeys) return memcmp(keyed->key, key, length) == 0 ? Yes : No;
+  return _LLKeyFoldEquals(keyed->key, key, length);
+}
+
+LLIntKeyed *LNIntKeyed(LinkNode *node)
+{
+  return node && node->type & LN_INT_KEYED ? (LLIntKeyed *)node->value : NULL;
+}
+
+void _LLKeyFilterCount(LLKeyFilter *filter, unsigned long keyHash, int delta)
+{
+  unsigned long step = ((keyHash >> 16) | (keyHash << 16)) * 0x9E3779B1UL | 1UL;
+  unsigned char *counter;
+  int i;
+
+  /* Double hashing derives all k probes from the one stored key hash */
+  for (i = 0; i < filter->hashes; i++, keyHash += step)
+  {
+    counter = &filter->counters[keyHash & (filter->size - 1)];
+    if (*counter == 255) continue;
+    if (delta > 0) (*counter)++;
+    else if (*counter) (*counter)--;
+  }
+}
+
+/* Reads a numeric node into value, and integer for LN_INTEGER nodes;
+ * returns the node's data type or 0 when it holds no number */
+int _LLNumericValue(LinkNode *node, MAX_DEC_TYPE *value, MAX_INT_TYPE *integer)
+{
+  int type = node->value ? node->type & LN_TYPE_MASK : 0;
+
+  if (type == LN_INTEGER)
+  {
+    *integer = LLIntegerValue(node->type & LN_KEYED
+      ? &((LLKeyedInteger *)node->value)->integer
+      : (LLIntegerNode *)node->value);
+    *value = (MAX_DEC_TYPE)*integer;
+  }
+  else if (type == LN_DECIMAL)
+  {
+    *value = LLDecimalValue(node->type & LN_KEYED
+      ? &((LLKeyedDecimal *)node->value)->decimal
+      : (LLDecimalNode *)node->value);
+  }
+  else type = 0;
+
+  return type;
+}
+
+void _LLAggregateNode(LLAggregates *aggregates, LinkNode *node, int delta)
+{
+  MAX_INT_TYPE integer = 0;
+  MAX_DEC_TYPE value;
+  int type = _LLNumericValue(node, &value, &integer);
+
+  if (!type) return;
+
+  if (type == LN_INTEGER) aggregates->integerSum += delta > 0 ? integer : -integer;
+  else aggregates->decimalSum += delta > 0 ? value : -value;
+
+  if (delta > 0)
+  {
+    /* A new extreme is exact even while the other bound is stale */
+    if (!aggregates->count++) aggregates->min = aggregates->max = value;
+    else if (value < aggregates->min) aggregates->min = value;
+    else if (value > aggregates->max) aggregates->max = value;
+    return;
+  }
+
+  if (!--aggregates->count) memset(aggregates, 0L, sizeof(LLAggregates));
+  else if (value <= aggregates->min || value >= aggregates->max) aggregates->stale = Yes;
+}
+
+void _LLNodeAttached(LinkList *list, LinkNode *node)
+{
+  LLKeyedNode *keyed;
+  LLIntKeyed *intKeyed;
+  LLVoid data;
+
+  LL_STAT_ADD(list, allocations, 1);
+  LL_STAT_ADD(list, bytesInUse, sizeof(LinkNode) + LLDataSize(node));
+  LL_STAT_ADD(list, length, 1);
+  #ifdef LL_STATS
+  if (list->stats.length > list->stats.peakLength) list->stats.peakLength = list->stats.length;
+  #endif
+
+  list->length++;
+  if (list->aggregates) _LLAggregateNode(list->aggregates, node, 1);
+
+  if (list->dataIndex && (data = LLNodeData(node)) != NULL)
+  {
+    LLIndexInsert(list->dataIndex, LLPointerHash(data), node);
+  }
+
+  if (list->keyIndex && (keyed = _LLNodeKeyed(node)) != NULL)
+  {
+    LLIndexInsert(list->keyIndex, keyed->keyHash, node);
+  }
+
+  if (list->intKeyIndex && (intKeyed = LNIntKeyed(node)) != NULL)
+  {
+    LLIndexInsert(list->intKeyIndex, LLIntKeyHash(intKeyed->key), node);
+  }
+
+  if (list->keyFilter && (keyed = _LLNodeKeyed(node)) != NULL)
+  {
+    _LLKeyFilterCount(list->keyFilter, keyed->keyHash, 1);
+  }
+}
+
+void _LLNodeDetached(LinkList *list, LinkNode *node)
+{
+  LLKeyedNode *keyed;
+  LLIntKeyed *intKeyed;
+  LLVoid data;
+
+  LL_STAT_ADD(list, bytesInUse, 0 - (sizeof(LinkNode) + LLDataSize(node)));
+  LL_STAT_ADD(list, length, -1);
+
+  list->length--;
+  if (list->aggregates) _LLAggregateNode(list->aggregates, node, -1);
+
+  if (list->dataIndex && (data = LLNodeData(node)) != NULL)
+  {
+    LLIndexRemove(list->dataIndex, LLPointerHash(data), node);
+  }
+
+  if (list->keyIndex && (keyed = _LLNodeKeyed(node)) != NULL)
+  {
+    LLIndexRemove(list->keyIndex, keyed->keyHash, node);
+  }
+
+  if (list->intKeyIndex && (intKeyed = LNIntKeyed(node)) != NULL)
+  {
+    LLIndexRemove(list->intKeyIndex, LLIntKeyHash(intKeyed->key), node);
+  }
+
+  if (list->keyFilter && (keyed = _LLNodeKeyed(node)) != NULL)
+  {
+    _LLKeyFilterCount(list->keyFilter, keyed->keyHash, -1);
+  }
+}
+
 #pragma mark - Utility Functions
 
 size_t LLDataSize(LinkNode *node)
 {
+  if (node->type & LN_INT_KEYED) return sizeof(LLIntKeyed);
+
   if (node->type & LN_KEYED)
   {
-  switch (node->type ^ LN_KEYED)
+  switch (node->type & LN_TYPE_MASK)
   {
     case LN_BOOLEAN: return sizeof(LLKeyedBool);
     case LN_INTEGER: return sizeof(LLKeyedInteger);
@@ -158,7 +416,7 @@ size_t LLDataSize(LinkNode *node)
   }
   else 
   {
-  switch (node->type)
+  switch (node->type & LN_TYPE_MASK)
   {
     case LN_BOOLEAN: return sizeof(LLBoolNode);
     case LN_INTEGER: return sizeof(LLIntegerNode);
@@ -169,31 +427,200 @@ size_t LLDataSize(LinkNode *node)
   }
 }
 
-LinkNode *LLFindKeyed(LinkList *list, LLKey key)
+LLVoid LLNodeData(LinkNode *node)
+{
+  if (!node || !node->value) return NULL;
+
+  /* Void nodes answer with the caller's pointer rather than our wrapper */
+  if ((node->type & LN_TYPE_MASK) == LN_VOID)
+    return node->type & LN_KEYED
+      ? ((LLKeyedVoid *)node->value)->voidNode.value
+      : ((LLVoidNode *)node->value)->value;
+
+  return node->value;
+}
+
+MAX_INT_TYPE LLIntegerValue(LLIntegerNode *node)
+{
+  LLBoolean isUnsigned = node->type & LLIN_UNSIGNED ? Yes : No;
+
+  switch (node->type & ~LLIN_UNSIGNED)
+  {
+    case LLIN_CHAR:
+      return isUnsigned ? (MAX_INT_TYPE)node->u.uc : (MAX_INT_TYPE)node->u.c;
+    case LLIN_SHORT:
+      return isUnsigned ? (MAX_INT_TYPE)node->u.us : (MAX_INT_TYPE)node->u.s;
+    case LLIN_INT:
+      return isUnsigned ? (MAX_INT_TYPE)node->u.ui : (MAX_INT_TYPE)node->u.i;
+    #ifdef BIG_TYPES
+    case LLIN_LONG:
+      return isUnsigned ? (MAX_INT_TYPE)node->u.ul : (MAX_INT_TYPE)node->u.l;
+    default:
+      return node->u.ll;
+    #else
+    default:
+      return node->u.l;
+    #endif
+  }
+}
+
+MAX_DEC_TYPE LLDecimalValue(LLDecimalNode *node)
+{
+  switch (node->type)
+  {
+    case LLDN_FLOAT:
+      return node->u.f;
+    #ifdef BIG_TYPES
+    case LLDN_LONG_DOUBLE:
+      return node->u.ld;
+    #endif
+    default:
+      return node->u.d;
+  }
+}
+
+/* With hashed Yes, hash is trusted to be LLKeyHash(key). Every candidate,
+ * indexed or scanned, is screened by its stored hash and then its length
+ * before the keys themselves are compared. */
+LinkNode *_LLFindKeyed(LinkList *list, LLKey key, unsigned long hash, LLBoolean hashed)
 {
   LinkNode *node  = list && list->head ? list->head : NULL;
   LLKeyedNode *keyedNode;
+  LLIndexEntry *entry;
+  size_t length;
+
+  if (!list) return NULL;
+  LL_STAT_ADD(list, lookups, 1);
+  if (!node)
+  {
+    LL_STAT_ADD(list, misses, 1);
+    return NULL;
+  }
+
+  if (!hashed) hash = _LLKeyHashLength(key, &length);
+  else length = strlen(key);
+
+  if (list->keyFilter)
+  {
+    list->keyFilter->queries++;
+    if (!LLKeyFilterMayContain(list->keyFilter, hash))
+    {
+      list->keyFilter->negatives++;
+      LL_STAT_ADD(list, misses, 1);
+      return NULL;
+    }
+  }
+
+  if (list->keyIndex)
+  {
+    for (entry = LLIndexFirst(list->keyIndex, hash); entry; entry = entry->next)
+    {
+      LL_STAT_ADD(list, nodesVisited, 1);
+      if (entry->hash != hash) continue;
+
+      keyedNode = (LLKeyedNode *)entry->node->value;
+      if (_LLKeyEquals(list, keyedNode, key, length))
+      {
+        LL_STAT_ADD(list, hits, 1);
+        return entry->node;
+      }
+    }
+    node = NULL;
+  }
   
   while (node) 
   {
+    LL_STAT_ADD(list, nodesVisited, 1);
     if (node->type & LN_KEYED)
     {
       keyedNode = (LLKeyedNode *)node->value;
-      if (keyedNode)
+      if (keyedNode && keyedNode->keyHash == hash && _LLKeyEquals(list, keyedNode, key, length))
       {
-        if (strcasecmp(key, keyedNode->key) == 0)
-        {
-          return node;
-        }
+        LL_STAT_ADD(list, hits, 1);
+        return node;
       }
     }
   
     node = node->next;
   }
   
+  if (list->keyFilter) list->keyFilter->falsePositives++;
+  LL_STAT_ADD(list, misses, 1);
   return NULL;
 }
 
+LinkNode *LLFindKeyed(LinkList *list, LLKey key)
+{
+  LLBoolean traced = LL_TRACE_BEGIN(LL_TRACE_FIND_KEYED, list, 0, key);
+  LinkNode *node = _LLFindKeyed(list, key, 0, No);
+
+  LL_TRACE_END(traced, LL_TRACE_FIND_KEYED, list, node ? node->type : 0, key);
+  return node;
+}
+
+LinkNode *LLFindKeyedHashed(LinkList *list, LLKey key, unsigned long hash)
+{
+  LLBoolean traced = LL_TRACE_BEGIN(LL_TRACE_FIND_KEYED, list, 0, key);
+  LinkNode *node = _LLFindKeyed(list, key, hash, Yes);
+
+  LL_TRACE_END(traced, LL_TRACE_FIND_KEYED, list, node ? node->type : 0, key);
+  return node;
+}
+
+LinkNode *LLFindIntKeyed(LinkList *list, LLIntKey key)
+{
+  LinkNode *node = list ? list->head : NULL;
+  LLIndexEntry *entry;
+  unsigned long hash;
+
+  if (!list) return NULL;
+  LL_STAT_ADD(list, lookups, 1);
+
+  if (list->intKeyIndex)
+  {
+    hash = LLIntKeyHash(key);
+    for (entry = LLIndexFirst(list->intKeyIndex, hash); entry; entry = entry->next)
+    {
+      LL_STAT_ADD(list, nodesVisited, 1);
+      if (entry->hash == hash && ((LLIntKeyed *)entry->node->value)->key == key)
+      {
+        LL_STAT_ADD(list, hits, 1);
+        return entry->node;
+      }
+    }
+    node = NULL;
+  }
+
+  for (; node; node = node->next)
+  {
+    LL_STAT_ADD(list, nodesVisited, 1);
+    if (node->type & LN_INT_KEYED && node->value && ((LLIntKeyed *)node->value)->key == key)
+    {
+      LL_STAT_ADD(list, hits, 1);
+      return node;
+    }
+  }
+
+  LL_STAT_ADD(list, misses, 1);
+  return NULL;
+}
+
+LinkNode *LLMoveNodeToTail(LinkList *list, LinkNode *node)
+{
+  if (!list || !node || list->tail == node) return node;
+
+  /* Relinks in place; membership is unchanged so indexes need no update */
+  if (list->head == node) list->head = node->next;
+  if (node->prev) node->prev->next = node->next;
+  if (node->next) node->next->prev = node->prev;
+
+  node->prev = list->tail;
+  node->next = NULL;
+  list->tail->next = node;
+  list->tail = node;
+  return node;
+}
+
 LLStringNode *LLDuplicateStringNode(LLStringNode *source)
 {
   LLStringNode *dest = LNSInit(NULL, Yes);
@@ -201,20 +628,604 @@ LLStringNode *LLDuplicateStringNode(LLStringNode *source)
   dest->type = source->type;
   switch (dest->type)
   {
-  default:
-  case LLSN_STRING:
-    dest->u.s = __strdup(source->u.s);
-    break;
-  #ifdef WCHAR_SUPPORT
-  case LLSN_WIDE:
-    dest->u.w = __wstrdup(source->u.w);
-    break;
-  #endif
+  default:
+  case LLSN_STRING:
+    dest->u.s = __strdup(source->u.s);
+    break;
+  #ifdef WCHAR_SUPPORT
+  case LLSN_WIDE:
+    dest->u.w = __wstrdup(source->u.w);
+    break;
+  #endif
+  }
+
+  return dest;
+}
+
+#pragma mark - Index Functions
+
+LLIndex *LLIndexCreate(size_t bucketCount)
+{
+  LLIndex *index = (LLIndex *)malloc(sizeof(LLIndex));
+  size_t count = 8;
+
+  if (!index) return NULL;
+
+  /* Bucket counts are kept at powers of two so masking selects a bucket */
+  while (count < bucketCount) count <<= 1;
+
+  index->buckets = (LLIndexEntry **)calloc(count * 2, sizeof(LLIndexEntry *));
+  if (!index->buckets)
+  {
+    free(index);
+    return NULL;
+  }
+  index->tails = index->buckets + count;
+  index->bucketCount = count;
+  index->count = 0;
+  return index;
+}
+
+void LLIndexDelete(LLIndex *index)
+{
+  LLIndexEntry *entry, *next;
+  size_t i;
+
+  if (!index) return;
+
+  for (i = 0; i < index->bucketCount; i++)
+  {
+    for (entry = index->buckets[i]; entry; entry = next)
+    {
+      next = entry->next;
+      free(entry);
+    }
+  }
+
+  free(index->buckets);
+  free(index);
+}
+
+/* Links entry onto the end of its chain so entries sharing a hash keep
+ * their insertion order */
+void _LLIndexAppend(LLIndex *index, LLIndexEntry *entry)
+{
+  size_t bucket = entry->hash & (index->bucketCount - 1);
+
+  entry->next = NULL;
+  if (index->tails[bucket]) index->tails[bucket]->next = entry;
+  else index->buckets[bucket] = entry;
+  index->tails[bucket] = entry;
+}
+
+void _LLIndexGrow(LLIndex *index)
+{
+  size_t count = index->bucketCount << 1, oldCount = index->bucketCount, i;
+  LLIndexEntry **buckets = (LLIndexEntry **)calloc(count * 2, sizeof(LLIndexEntry *));
+  LLIndexEntry **old = index->buckets, *entry, *next;
+
+  /* Without memory to grow the chains simply get longer */
+  if (!buckets) return;
+
+  index->buckets = buckets;
+  index->tails = buckets + count;
+  index->bucketCount = count;
+
+  for (i = 0; i < oldCount; i++)
+  {
+    for (entry = old[i]; entry; entry = next)
+    {
+      next = entry->next;
+      _LLIndexAppend(index, entry);
+    }
+  }
+
+  free(old);
+}
+
+/* Moves every entry of from into index, relinking rather than reallocating.
+ * Chains of equally sized tables are spliced whole through their tails. */
+void _LLIndexMerge(LLIndex *index, LLIndex *from)
+{
+  LLIndexEntry *entry, *next;
+  size_t count, i;
+
+  /* Grow once up front so no entry is relinked twice */
+  while (index->count + from->count > index->bucketCount)
+  {
+    count = index->bucketCount;
+    _LLIndexGrow(index);
+    if (index->bucketCount == count) break;
+  }
+
+  for (i = 0; i < from->bucketCount; i++)
+  {
+    if (!from->buckets[i]) continue;
+
+    if (index->bucketCount == from->bucketCount)
+    {
+      if (index->tails[i]) index->tails[i]->next = from->buckets[i];
+      else index->buckets[i] = from->buckets[i];
+      index->tails[i] = from->tails[i];
+    }
+    else
+    {
+      for (entry = from->buckets[i]; entry; entry = next)
+      {
+        next = entry->next;
+        _LLIndexAppend(index, entry);
+      }
+    }
+
+    from->buckets[i] = NULL;
+    from->tails[i] = NULL;
+  }
+
+  index->count += from->count;
+  from->count = 0;
+}
+
+void _LLIndexClear(LLIndex *index)
+{
+  LLIndexEntry *entry, *next;
+  size_t i;
+
+  for (i = 0; i < index->bucketCount; i++)
+  {
+    for (entry = index->buckets[i]; entry; entry = next)
+    {
+      next = entry->next;
+      free(entry);
+    }
+    index->buckets[i] = NULL;
+    index->tails[i] = NULL;
+  }
+
+  index->count = 0;
+}
+
+void LLIndexInsert(LLIndex *index, unsigned long hash, LinkNode *node)
+{
+  LLIndexEntry *entry = (LLIndexEntry *)malloc(sizeof(LLIndexEntry));
+
+  if (!entry) return;
+
+  if (index->count >= index->bucketCount) _LLIndexGrow(index);
+
+  entry->hash = hash;
+  entry->node = node;
+  _LLIndexAppend(index, entry);
+  index->count++;
+}
+
+LLBoolean LLIndexRemove(LLIndex *index, unsigned long hash, LinkNode *node)
+{
+  size_t bucket = hash & (index->bucketCount - 1);
+  LLIndexEntry **link = &index->buckets[bucket];
+  LLIndexEntry *entry, *prev = NULL;
+
+  while ((entry = *link) != NULL)
+  {
+    if (entry->node == node)
+    {
+      *link = entry->next;
+      if (index->tails[bucket] == entry) index->tails[bucket] = prev;
+      free(entry);
+      index->count--;
+      return Yes;
+    }
+    prev = entry;
+    link = &entry->next;
+  }
+
+  return No;
+}
+
+LLIndexEntry *LLIndexFirst(LLIndex *index, unsigned long hash)
+{
+  LLIndexEntry *entry = index->buckets[hash & (index->bucketCount - 1)];
+
+  while (entry && entry->hash != hash) entry = entry->next;
+  return entry;
+}
+
+unsigned long LLPointerHash(LLVoid pointer)
+{
+  unsigned long hash = (unsigned long)(size_t)pointer;
+
+  /* Allocations are aligned, so fold the high bits down over the zeros */
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3bUL;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+unsigned long LLIntKeyHash(LLIntKey key)
+{
+  unsigned long hash = (unsigned long)key;
+
+  /* Fold in any bits above 32, then mix so strided ids spread evenly */
+  hash ^= (unsigned long)((key >> 16) >> 16);
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3bUL;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+LLBoolean LLEnableDataIndex(LinkList *list, LLBoolean enable)
+{
+  LinkNode *node;
+  LLVoid data;
+
+  if (!list) return No;
+
+  if (!enable)
+  {
+    LLIndexDelete(list->dataIndex);
+    list->dataIndex = NULL;
+    return Yes;
+  }
+
+  if (list->dataIndex) return Yes;
+
+  list->dataIndex = LLIndexCreate(64);
+  if (!list->dataIndex) return No;
+
+  for (node = list->head; node; node = node->next)
+  {
+    if ((data = LLNodeData(node)) != NULL)
+    {
+      LLIndexInsert(list->dataIndex, LLPointerHash(data), node);
+    }
+  }
+
+  return Yes;
+}
+
+LLBoolean LLEnableKeyIndex(LinkList *list, LLBoolean enable)
+{
+  LLKeyedNode *keyed;
+  LinkNode *node;
+
+  if (!list) return No;
+
+  if (!enable)
+  {
+    LLIndexDelete(list->keyIndex);
+    list->keyIndex = NULL;
+    return Yes;
+  }
+
+  if (list->keyIndex) return Yes;
+
+  list->keyIndex = LLIndexCreate(64);
+  if (!list->keyIndex) return No;
+
+  for (node = list->head; node; node = node->next)
+  {
+    if ((keyed = _LLNodeKeyed(node)) != NULL)
+    {
+      LLIndexInsert(list->keyIndex, keyed->keyHash, node);
+    }
+  }
+
+  return Yes;
+}
+
+LLBoolean LLEnableIntKeyIndex(LinkList *list, LLBoolean enable)
+{
+  LLIntKeyed *intKeyed;
+  LinkNode *node;
+
+  if (!list) return No;
+
+  if (!enable)
+  {
+    LLIndexDelete(list->intKeyIndex);
+    list->intKeyIndex = NULL;
+    return Yes;
+  }
+
+  if (list->intKeyIndex) return Yes;
+
+  list->intKeyIndex = LLIndexCreate(64);
+  if (!list->intKeyIndex) return No;
+
+  for (node = list->head; node; node = node->next)
+  {
+    if ((intKeyed = LNIntKeyed(node)) != NULL)
+    {
+      LLIndexInsert(list->intKeyIndex, LLIntKeyHash(intKeyed->key), node);
+    }
+  }
+
+  return Yes;
+}
+
+LLBoolean LLEnableKeyFilter(LinkList *list, LLBoolean enable, size_t expectedKeys)
+{
+  LLKeyFilter *filter;
+  LLKeyedNode *keyed;
+  LinkNode *node;
+  size_t size = 64;
+
+  if (!list) return No;
+
+  if (list->keyFilter)
+  {
+    free(list->keyFilter->counters);
+    free(list->keyFilter);
+    list->keyFilter = NULL;
+  }
+
+  if (!enable) return Yes;
+
+  /* Ten counters and seven probes per key gives close to a 1% error rate */
+  while (size < expectedKeys * 10) size <<= 1;
+
+  filter = (LLKeyFilter *)malloc(sizeof(LLKeyFilter));
+  if (!filter) return No;
+  memset(filter, 0L, sizeof(LLKeyFilter));
+
+  filter->counters = (unsigned char *)calloc(size, 1);
+  if (!filter->counters)
+  {
+    free(filter);
+    return No;
+  }
+  filter->size = size;
+  filter->hashes = 7;
+
+  for (node = list->head; node; node = node->next)
+  {
+    if ((keyed = _LLNodeKeyed(node)) != NULL)
+    {
+      _LLKeyFilterCount(filter, keyed->keyHash, 1);
+    }
+  }
+
+  list->keyFilter = filter;
+  return Yes;
+}
+
+LLBoolean LLEnableCaseSensitiveKeys(LinkList *list, LLBoolean enable)
+{
+  if (!list) return No;
+
+  /* Hashes are case folded in both modes, so no index or filter changes */
+  list->caseSensitiveKeys = enable;
+  if (!enable && list->uniqueKeys) return LLEnableUniqueKeys(list, Yes);
+  return Yes;
+}
+
+LLBoolean LLKeyFilterMayContain(LLKeyFilter *filter, unsigned long keyHash)
+{
+  unsigned long step = ((keyHash >> 16) | (keyHash << 16)) * 0x9E3779B1UL | 1UL;
+  int i;
+
+  for (i = 0; i < filter->hashes; i++, keyHash += step)
+  {
+    if (!filter->counters[keyHash & (filter->size - 1)]) return No;
+  }
+
+  return Yes;
+}
+
+void LLGetKeyFilterStats(LinkList *list, LLKeyFilterStats *stats)
+{
+  LLKeyFilter *filter = list ? list->keyFilter : NULL;
+  size_t used = 0, i;
+  double fill;
+  int k;
+
+  memset(stats, 0L, sizeof(LLKeyFilterStats));
+  if (!filter) return;
+
+  stats->queries = filter->queries;
+  stats->negatives = filter->negatives;
+  stats->falsePositives = filter->falsePositives;
+  if (filter->negatives + filter->falsePositives)
+  {
+    stats->falsePositiveRate = (double)filter->falsePositives
+      / (double)(filter->negatives + filter->falsePositives);
+  }
+
+  /* An absent key passes when all k probes land on occupied counters */
+  for (i = 0; i < filter->size; i++) if (filter->counters[i]) used++;
+  fill = (double)used / (double)filter->size;
+  for (stats->expectedRate = 1.0, k = 0; k < filter->hashes; k++) stats->expectedRate *= fill;
+}
+
+#pragma mark - Length and Aggregate Functions
+
+unsigned long LLLength(LinkList *list)
+{
+  return list ? list->length : 0;
+}
+
+LLBoolean LLEnableAggregates(LinkList *list, LLBoolean enable)
+{
+  LinkNode *node;
+
+  if (!list) return No;
+
+  if (list->aggregates)
+  {
+    free(list->aggregates);
+    list->aggregates = NULL;
+  }
+
+  if (!enable) return Yes;
+
+  list->aggregates = (LLAggregates *)malloc(sizeof(LLAggregates));
+  if (!list->aggregates) return No;
+  memset(list->aggregates, 0L, sizeof(LLAggregates));
+
+  for (node = list->head; node; node = node->next)
+  {
+    _LLAggregateNode(list->aggregates, node, 1);
+  }
+
+  return Yes;
+}
+
+LLBoolean LLGetAggregates(LinkList *list, LLAggregates *aggregates)
+{
+  LLAggregates *current = list ? list->aggregates : NULL;
+  MAX_INT_TYPE integer;
+  MAX_DEC_TYPE value;
+  LLBoolean first = Yes;
+  LinkNode *node;
+
+  memset(aggregates, 0L, sizeof(LLAggregates));
+  if (!current) return No;
+
+  if (current->stale)
+  {
+    for (node = list->head; node; node = node->next)
+    {
+      if (!_LLNumericValue(node, &value, &integer)) continue;
+
+      if (first || value < current->min) current->min = value;
+      if (first || value > current->max) current->max = value;
+      first = No;
+    }
+
+    current->stale = No;
+  }
+
+  *aggregates = *current;
+  return Yes;
+}
+
+#pragma mark - Statistics Functions
+
+int LLStatsTypeIndex(int type)
+{
+  switch (type & LN_TYPE_MASK)
+  {
+    case LN_BOOLEAN: return 1;
+    case LN_INTEGER: return 2;
+    case LN_DECIMAL: return 3;
+    case LN_STRING: return 4;
+    case LN_VOID: return 5;
+    default: return 0;
+  }
+}
+
+LLBoolean LLGetStats(LinkList *list, LLStats *stats)
+{
+  #ifdef LL_STATS
+  *stats = list->stats;
+  return Yes;
+  #else
+  (void)list;
+  memset(stats, 0L, sizeof(LLStats));
+  return No;
+  #endif
+}
+
+void LLResetStats(LinkList *list)
+{
+  #ifdef LL_STATS
+  unsigned long length = list->stats.length, bytesInUse = list->stats.bytesInUse;
+
+  memset(&list->stats, 0L, sizeof(LLStats));
+  list->stats.length = length;
+  list->stats.peakLength = length;
+  list->stats.bytesInUse = bytesInUse;
+  #else
+  (void)list;
+  #endif
+}
+
+#pragma mark - Tracing Functions
+
+LLTraceFn _LLTraceBegin = NULL;
+LLTraceFn _LLTraceEnd = NULL;
+LLVoid _LLTraceContext = NULL;
+unsigned long _LLTraceEvery = 1;
+unsigned long _LLTraceTick = 0;
+
+void _LLTraceNothing(LLTraceOp op, LinkList *list, int type, LLKey key, LLVoid context)
+{
+  (void)op;
+  (void)list;
+  (void)type;
+  (void)key;
+  (void)context;
+}
+
+void LLSetTraceHooks(LLTraceFn begin, LLTraceFn end, unsigned long sampleEvery, LLVoid context)
+{
+  _LLTraceBegin = NULL;
+  _LLTraceEnd = end;
+  _LLTraceContext = context;
+  _LLTraceEvery = sampleEvery ? sampleEvery : 1;
+  _LLTraceTick = 0;
+
+  /* Set last, or when only end is wanted a no-op begin stands in for it */
+  _LLTraceBegin = begin || !end ? begin : _LLTraceNothing;
+}
+
+LLBoolean _LLTraceSample(LLTraceOp op, LinkList *list, int type, LLKey key)
+{
+  if (++_LLTraceTick < _LLTraceEvery) return No;
+
+  _LLTraceTick = 0;
+  _LLTraceBegin(op, list, type, key, _LLTraceContext);
+  return Yes;
+}
+
+void _LLTraceReport(LLTraceOp op, LinkList *list, int type, LLKey key)
+{
+  if (_LLTraceEnd) _LLTraceEnd(op, list, type, key, _LLTraceContext);
+}
+
+LLKey _LLTraceKey(LinkNode *node)
+{
+  LLKeyedNode *keyed = node ? _LLNodeKeyed(node) : NULL;
+  return keyed ? keyed->key : NULL;
+}
+
+#pragma mark - Block Allocation Functions
+
+LLBlockNode *LLNodeBlockCreate(size_t count, size_t arenaSize, char **arena)
+{
+  LLNodeBlock *block;
+  LLBlockNode *nodes;
+  size_t i;
+
+  if (!count) return NULL;
+
+  block = (LLNodeBlock *)malloc(sizeof(LLNodeBlock) + count * sizeof(LLBlockNode) + arenaSize);
+  if (!block) return NULL;
+
+  block->live = count;
+  nodes = (LLBlockNode *)(block + 1);
+  if (arena) *arena = (char *)(nodes + count);
+
+  for (i = 0; i < count; i++)
+  {
+    nodes[i].link.next = NULL;
+    nodes[i].link.prev = NULL;
+    nodes[i].link.value = &nodes[i].u;
+    nodes[i].link.type = LN_BLOCK;
+    nodes[i].block = block;
   }
 
-  return dest;
+  return nodes;
 }
 
+void LNKSetKey(LLKeyedNode *node, LLKey key)
+{
+  size_t length;
+
+  node->key = key;
+  node->hashValue = LLDefaultHashFunction(key, LLDefaultHashLimit);
+  node->keyHash = _LLKeyHashLength(key, &length);
+  node->keyLength = (unsigned int)length;
+}
 
 #pragma mark - Initialization Functions
 
@@ -690,9 +1701,12 @@ LLKeyedNode *LNKCreate(LLKey key, LLHashFn hashFunction)
 {
   LLHashFn hashMe = hashFunction ? hashFunction : LLDefaultHashFunction;
   LLKeyedNode *node = LNKNInit(NULL, Yes);
+  size_t length;
 
   node->key = __strdup(key);
   node->hashValue = hashMe(key, LLDefaultHashLimit);
+  node->keyHash = _LLKeyHashLength(key, &length);
+  node->keyLength = (unsigned int)length;
   return node;  
 }
 
@@ -743,6 +1757,7 @@ LLKeyedBool *LNKBCreate(LLKey key, LLBoolean boolean)
 
   memcpy(&node->keyedNode, keyNode, sizeof(LLKeyedNode));
   node->boolean = boolean;
+  free(keyNode);
   return node;
 }
 
@@ -755,6 +1770,8 @@ LLKeyedInteger *LNKICreate(LLKey key, MAX_INT_TYPE value, LLIntegerType type)
 
   memcpy(&node->keyedNode, keyNode, sizeof(LLKeyedNode));
   memcpy(&node->integer, data, sizeof(LLIntegerNode));
+  free(keyNode);
+  free(data);
   return node;
 }
 
@@ -767,6 +1784,8 @@ LLKeyedDecimal *LNKDCreate(LLKey key, MAX_DEC_TYPE value, LLDecimalType type)
 
   memcpy(&node->keyedNode, keyNode, sizeof(LLKeyedNode));
   memcpy(&node->decimal, data, sizeof(LLDecimalNode));
+  free(keyNode);
+  free(data);
   return node;
 }
 
@@ -779,6 +1798,8 @@ LLKeyedString *LNKSCreate(LLKey key, LLVoid string, LLStringType type)
   
   memcpy(&node->keyedNode, keyNode, sizeof(LLKeyedNode));
   memcpy(&node->string, data, sizeof(LLStringNode));
+  free(keyNode);
+  free(data);
   return node;
 }
 
@@ -791,13 +1812,25 @@ LLKeyedVoid *LNKVCreate(LLKey key, LLVoid value)
 
   memcpy(&node->keyedNode, keyNode, sizeof(LLKeyedNode));
   memcpy(&node->voidNode, data, sizeof(LLVoidNode));
+  free(keyNode);
+  free(data);
   return node;
+}
+
+LLIntKeyed *LNIKCreate(LLIntKey key)
+{
+  LLIntKeyed *node = (LLIntKeyed *)malloc(sizeof(LLIntKeyed));
 
+  if (!node) return NULL;
+  memset(node, 0L, sizeof(LLIntKeyed));
+  node->key = key;
+  return node;
 }
 
 #pragma mark - Deallocation Functions
 
-void LLDelete(LinkList *list)
+/* Releases everything the list owns, leaving it allocated and empty */
+void _LLDeleteContents(LinkList *list)
 {
   LinkNode *node = list->head, *next;
   while (node) 
@@ -807,13 +1840,29 @@ void LLDelete(LinkList *list)
   node = next;
   }
   
+  LLIndexDelete(list->dataIndex);
+  LLIndexDelete(list->keyIndex);
+  LLIndexDelete(list->intKeyIndex);
+  list->head = list->tail = NULL;
+  list->length = 0;
+  list->dataIndex = list->keyIndex = list->intKeyIndex = NULL;
+  LLEnableKeyFilter(list, No, 0);
+  LLEnableAggregates(list, No);
+}
+
+void LLDelete(LinkList *list)
+{
+  LLBoolean traced = LL_TRACE_BEGIN(LL_TRACE_DELETE, list, 0, NULL);
+
+  _LLDeleteContents(list);
+  LL_TRACE_END(traced, LL_TRACE_DELETE, list, 0, NULL);
   free(list);
 }
 
 void LNDelete(LinkNode *node)
 {
   LLBoolean isKeyed = node->type & LN_KEYED ? Yes : No;
-  int unkeyedType = isKeyed ? node->type ^ LN_KEYED : node->type;
+  int unkeyedType = node->type & LN_TYPE_MASK;
   LLVoid data = node->value;
 
   LLBoolNode *boolNode;
@@ -825,8 +1874,17 @@ void LNDelete(LinkNode *node)
   LLKeyedInteger *keyedInt;
   LLKeyedDecimal *keyedDec;
   LLKeyedString *keyedStr;
+  LLKeyedVoid *keyedVoid;
+
+  /* Block nodes own nothing individually; the last one frees the block.
+   * An LLIntKeyed is freed below as the unkeyed value it starts with. */
+  if (node->type & LN_BLOCK)
+  {
+    if (--((LLBlockNode *)node)->block->live == 0) free(((LLBlockNode *)node)->block);
+    return;
+  }
 
-  if (node->type) 
+  if (unkeyedType) 
   {
     switch (unkeyedType)
     {
@@ -883,6 +1941,15 @@ void LNDelete(LinkNode *node)
 
         break;
       case LN_VOID:
+        /* The pointer itself belongs to the caller; only the wrapper is ours */
+        keyedVoid = isKeyed ? (LLKeyedVoid *)data : NULL;
+
+        if (keyedVoid) {
+          if (keyedVoid->keyedNode.key) free(keyedVoid->keyedNode.key);
+          free(keyedVoid);
+        }
+        else if (data) free(data);
+
         break;
     }
   }
@@ -892,8 +1959,45 @@ void LNDelete(LinkNode *node)
 
 #pragma mark - List Push Functions
 
-LinkNode *LLPush(LinkList *list, LinkNode *node)
+/* Puts node where old stands in the list, then deletes old */
+void _LLReplaceNode(LinkList *list, LinkNode *old, LinkNode *node)
 {
+  node->prev = old->prev;
+  node->next = old->next;
+
+  if (old->prev) old->prev->next = node;
+  else list->head = node;
+  if (old->next) old->next->prev = node;
+  else list->tail = node;
+
+  old->next = NULL;
+  old->prev = NULL;
+
+  _LLNodeDetached(list, old);
+  _LLNodeAttached(list, node);
+  LNDelete(old);
+}
+
+LinkNode *_LLPushNode(LinkList *list, LinkNode *node)
+{
+  LLKeyedNode *keyed;
+  LLIntKeyed *intKeyed;
+  LinkNode *existing = NULL;
+
+  LL_STAT_ADD(list, pushes[LLStatsTypeIndex(node->type)], 1);
+
+  if (list->uniqueKeys)
+  {
+    if ((keyed = _LLNodeKeyed(node)) != NULL) existing = LLFindKeyed(list, keyed->key);
+    else if ((intKeyed = LNIntKeyed(node)) != NULL) existing = LLFindIntKeyed(list, intKeyed->key);
+  }
+
+  if (existing)
+  {
+    _LLReplaceNode(list, existing, node);
+    return node;
+  }
+
   if (!list->tail) 
   {
     if (!list->head)
@@ -910,6 +2014,16 @@ LinkNode *LLPush(LinkList *list, LinkNode *node)
   node->next = NULL;
   }
   
+  _LLNodeAttached(list, node);
+  return node;
+}
+
+LinkNode *LLPush(LinkList *list, LinkNode *node)
+{
+  LLBoolean traced = LL_TRACE_BEGIN(LL_TRACE_PUSH, list, node->type, _LLTraceKey(node));
+
+  _LLPushNode(list, node);
+  LL_TRACE_END(traced, LL_TRACE_PUSH, list, node->type, _LLTraceKey(node));
   return node;
 }
 
@@ -974,65 +2088,483 @@ LinkNode *LLPushKeyedBoolean(LinkList *list, LLKey key, LLBoolean boolean)
   return node;
 }
 
-
-LinkNode *LLPushKeyedInteger(
-  LinkList *list, 
-  LLKey key, 
-  MAX_INT_TYPE value, 
-  LLIntegerType type
-) 
+
+LinkNode *LLPushKeyedInteger(
+  LinkList *list, 
+  LLKey key, 
+  MAX_INT_TYPE value, 
+  LLIntegerType type
+) 
+{
+  LLKeyedInteger *data = LNKICreate(key, value, type);
+  LinkNode *node = LNCreate(data, LN_INTEGER | LN_KEYED);
+  LLPush(list, node);
+  return node;
+}
+
+
+LinkNode *LLPushKeyedDecimal(LinkList *list, LLKey key, MAX_DEC_TYPE value, LLDecimalType type)
+{
+  LLKeyedDecimal *data = LNKDCreate(key, value, type);
+  LinkNode *node = LNCreate(data, LN_DECIMAL | LN_KEYED);
+  LLPush(list, node);
+  return node;  
+}
+
+
+LinkNode *LLPushKeyedString(LinkList *list, LLKey key, LLVoid string, LLStringType type)
+{
+  LLKeyedString *data = LNKSCreate(key, string, type);
+  LinkNode *node = LNCreate(data, LN_STRING | LN_KEYED);
+  LLPush(list, node);
+  return node;  
+}
+
+
+LinkNode *LLPushKeyedVoid(LinkList *list, LLKey key, LLVoid value)
+{
+  LLKeyedVoid *data = LNKVCreate(key, value);
+  LinkNode *node = LNCreate(data, LN_VOID | LN_KEYED);
+  LLPush(list, node);
+  return node;
+}
+
+/* Wraps an LLIntKeyed already holding its value in a node and pushes it */
+LinkNode *_LLPushIntKeyed(LinkList *list, LLIntKeyed *data, int type)
+{
+  LinkNode *node = LNCreate(data, (LinkNodeDataType)(type | LN_INT_KEYED));
+  LLPush(list, node);
+  return node;
+}
+
+LinkNode *LLPushIntKeyedBoolean(LinkList *list, LLIntKey key, LLBoolean boolean)
+{
+  LLIntKeyed *data = LNIKCreate(key);
+
+  data->u.b.boolean = boolean;
+  return _LLPushIntKeyed(list, data, LN_BOOLEAN);
+}
+
+LinkNode *LLPushIntKeyedInteger(LinkList *list, LLIntKey key, MAX_INT_TYPE value, LLIntegerType type)
+{
+  LLIntKeyed *data = LNIKCreate(key);
+
+  LNSetIntByType(&data->u.i, type, value);
+  return _LLPushIntKeyed(list, data, LN_INTEGER);
+}
+
+LinkNode *LLPushIntKeyedDecimal(LinkList *list, LLIntKey key, MAX_DEC_TYPE value, LLDecimalType type)
+{
+  LLIntKeyed *data = LNIKCreate(key);
+
+  LNSetDecByType(&data->u.d, type, value);
+  return _LLPushIntKeyed(list, data, LN_DECIMAL);
+}
+
+LinkNode *LLPushIntKeyedString(LinkList *list, LLIntKey key, LLVoid string, LLStringType type)
+{
+  LLIntKeyed *data = LNIKCreate(key);
+
+  LNSetStrByType(&data->u.s, type, string);
+  return _LLPushIntKeyed(list, data, LN_STRING);
+}
+
+LinkNode *LLPushIntKeyedVoid(LinkList *list, LLIntKey key, LLVoid value)
+{
+  LLIntKeyed *data = LNIKCreate(key);
+
+  data->u.v.value = value;
+  return _LLPushIntKeyed(list, data, LN_VOID);
+}
+
+#pragma mark - List Batch Push Functions
+
+/* Allocates count block nodes with valueSize arena bytes for the caller
+ * followed by copies of the keys; keyed slots come back flagged LN_KEYED
+ * with their LLKeyedNode, which leads every keyed value, already filled */
+LLBlockNode *_LLBatchCreate(size_t count, const LLKey *keys, size_t valueSize, char **arena)
+{
+  LLBlockNode *nodes;
+  LLKeyedNode *keyed;
+  size_t keysSize = 0, i;
+  char *copy, *local;
+
+  if (!arena) arena = &local;
+
+  /* Keyed slots are laid out as keyed values, so a missing key fails the
+   * whole batch before anything is sized or allocated */
+  for (i = 0; keys && i < count; i++)
+  {
+    if (!keys[i]) return NULL;
+    if (!i || keys[i] != keys[i - 1]) keysSize += strlen(keys[i]) + 1;
+  }
+
+  nodes = LLNodeBlockCreate(count, valueSize + keysSize, arena);
+  if (!nodes || !keys) return nodes;
+
+  copy = *arena + valueSize;
+  for (i = 0; i < count; i++)
+  {
+    keyed = (LLKeyedNode *)&nodes[i].u;
+    nodes[i].link.type |= LN_KEYED;
+
+    if (i && keys[i] == keys[i - 1])
+    {
+      *keyed = *(LLKeyedNode *)&nodes[i - 1].u;
+      continue;
+    }
+
+    strcpy(copy, keys[i]);
+    LNKSetKey(keyed, copy);
+    copy += strlen(copy) + 1;
+  }
+
+  return nodes;
+}
+
+size_t _LLBatchStringSize(LLVoid string, LLStringType type)
+{
+  if (!string) return 0;
+
+  #ifdef WCHAR_SUPPORT
+  if (type == LLSN_WIDE) return (wcslen((wchar_t *)string) + 1) * sizeof(wchar_t);
+  #else
+  (void)type;
+  #endif
+
+  return strlen((char *)string) + 1;
+}
+
+LinkNode *LLPushBlock(LinkList *list, LLBlockNode *nodes, size_t count)
+{
+  LLKeyedNode *keyed;
+  size_t i;
+
+  if (!count) return NULL;
+
+  /* Each node may replace an earlier one, even from the same run */
+  if (list->uniqueKeys)
+  {
+    for (i = 0; i < count; i++) LLPush(list, &nodes[i].link);
+
+    keyed = _LLNodeKeyed(&nodes[0].link);
+    return keyed ? LLFindKeyed(list, keyed->key) : &nodes[0].link;
+  }
+
+  for (i = 0; i + 1 < count; i++)
+  {
+    nodes[i].link.next = &nodes[i + 1].link;
+    nodes[i + 1].link.prev = &nodes[i].link;
+  }
+
+  nodes[0].link.prev = list->tail;
+  nodes[count - 1].link.next = NULL;
+
+  if (list->tail) list->tail->next = &nodes[0].link;
+  else list->head = &nodes[0].link;
+  list->tail = &nodes[count - 1].link;
+
+  for (i = 0; i < count; i++)
+  {
+    LL_STAT_ADD(list, pushes[LLStatsTypeIndex(nodes[i].link.type)], 1);
+    _LLNodeAttached(list, &nodes[i].link);
+  }
+
+  return &nodes[0].link;
+}
+
+LinkNode *LLPushBooleans(LinkList *list, const LLBoolean *values, size_t count)
+{
+  return LLPushKeyedBooleans(list, NULL, values, count);
+}
+
+LinkNode *LLPushIntegers(LinkList *list, const MAX_INT_TYPE *values, size_t count, LLIntegerType type)
+{
+  return LLPushKeyedIntegers(list, NULL, values, count, type);
+}
+
+LinkNode *LLPushDecimals(LinkList *list, const MAX_DEC_TYPE *values, size_t count, LLDecimalType type)
+{
+  return LLPushKeyedDecimals(list, NULL, values, count, type);
+}
+
+LinkNode *LLPushStrings(LinkList *list, const LLVoid *strings, size_t count, LLStringType type)
+{
+  return LLPushKeyedStrings(list, NULL, strings, count, type);
+}
+
+LinkNode *LLPushVoids(LinkList *list, const LLVoid *values, size_t count)
+{
+  return LLPushKeyedVoids(list, NULL, values, count);
+}
+
+LinkNode *LLPushKeyedBooleans(LinkList *list, const LLKey *keys, const LLBoolean *values, size_t count)
+{
+  LLBlockNode *nodes = _LLBatchCreate(count, keys, 0, NULL);
+  size_t i;
+
+  if (!nodes) return NULL;
+
+  for (i = 0; i < count; i++)
+  {
+    if (keys) nodes[i].u.kb.boolean = values[i];
+    else nodes[i].u.b.boolean = values[i];
+    nodes[i].link.type |= LN_BOOLEAN;
+  }
+
+  return LLPushBlock(list, nodes, count);
+}
+
+LinkNode *LLPushKeyedIntegers(
+  LinkList *list,
+  const LLKey *keys,
+  const MAX_INT_TYPE *values,
+  size_t count,
+  LLIntegerType type
+)
+{
+  LLBlockNode *nodes = _LLBatchCreate(count, keys, 0, NULL);
+  size_t i;
+
+  if (!nodes) return NULL;
+
+  for (i = 0; i < count; i++)
+  {
+    LNSetIntByType(keys ? &nodes[i].u.ki.integer : &nodes[i].u.i, type, values[i]);
+    nodes[i].link.type |= LN_INTEGER;
+  }
+
+  return LLPushBlock(list, nodes, count);
+}
+
+LinkNode *LLPushKeyedDecimals(
+  LinkList *list,
+  const LLKey *keys,
+  const MAX_DEC_TYPE *values,
+  size_t count,
+  LLDecimalType type
+)
+{
+  LLBlockNode *nodes = _LLBatchCreate(count, keys, 0, NULL);
+  size_t i;
+
+  if (!nodes) return NULL;
+
+  for (i = 0; i < count; i++)
+  {
+    LNSetDecByType(keys ? &nodes[i].u.kd.decimal : &nodes[i].u.d, type, values[i]);
+    nodes[i].link.type |= LN_DECIMAL;
+  }
+
+  return LLPushBlock(list, nodes, count);
+}
+
+LinkNode *LLPushKeyedStrings(
+  LinkList *list,
+  const LLKey *keys,
+  const LLVoid *strings,
+  size_t count,
+  LLStringType type
+)
+{
+  LLBlockNode *nodes;
+  LLStringNode *string;
+  size_t stringsSize = 0, size, i;
+  char *arena;
+
+  /* Strings lead the arena so wide ones stay aligned ahead of the keys */
+  for (i = 0; i < count; i++) stringsSize += _LLBatchStringSize(strings[i], type);
+
+  nodes = _LLBatchCreate(count, keys, stringsSize, &arena);
+  if (!nodes) return NULL;
+
+  for (i = 0; i < count; i++)
+  {
+    string = keys ? &nodes[i].u.ks.string : &nodes[i].u.s;
+    size = _LLBatchStringSize(strings[i], type);
+
+    string->type = type;
+    string->u.s = size ? arena : NULL;
+    if (size) memcpy(arena, strings[i], size);
+    arena += size;
+
+    nodes[i].link.type |= LN_STRING;
+  }
+
+  return LLPushBlock(list, nodes, count);
+}
+
+LinkNode *LLPushKeyedVoids(LinkList *list, const LLKey *keys, const LLVoid *values, size_t count)
+{
+  LLBlockNode *nodes = _LLBatchCreate(count, keys, 0, NULL);
+  size_t i;
+
+  if (!nodes) return NULL;
+
+  for (i = 0; i < count; i++)
+  {
+    if (keys) nodes[i].u.kv.voidNode.value = values[i];
+    else nodes[i].u.v.value = values[i];
+    nodes[i].link.type |= LN_VOID;
+  }
+
+  return LLPushBlock(list, nodes, count);
+}
+
+#pragma mark - List Upsert Functions
+
+LLBoolean LLEnableUniqueKeys(LinkList *list, LLBoolean enable)
+{
+  LLKeyedNode *keyed;
+  LLIntKeyed *intKeyed;
+  LinkNode *node, *first;
+
+  if (!list) return No;
+
+  list->uniqueKeys = enable;
+  if (!enable) return Yes;
+  if (!list->keyIndex && !LLEnableKeyIndex(list, Yes)) return No;
+  if (!list->intKeyIndex && !LLEnableIntKeyIndex(list, Yes)) return No;
+
+  /* The index finds the earliest node for a key, so every node that is
+   * not the earliest is a newer duplicate that supersedes it */
+  for (node = list->head; node; node = node->next)
+  {
+    if ((keyed = _LLNodeKeyed(node)) != NULL)
+    {
+      while ((first = LLFindKeyed(list, keyed->key)) != node)
+      {
+        LLRemoveNode(list, first);
+        LNDelete(first);
+      }
+    }
+    else if ((intKeyed = LNIntKeyed(node)) != NULL)
+    {
+      while ((first = LLFindIntKeyed(list, intKeyed->key)) != node)
+      {
+        LLRemoveNode(list, first);
+        LNDelete(first);
+      }
+    }
+  }
+
+  return Yes;
+}
+
+/* Nodes of the same type are updated in place; strings in a node block
+ * cannot take a heap copy, so those and type changes swap the node */
+LLBoolean _LLUpsertInPlace(LinkNode *node, int type)
+{
+  if (!node || !node->value || (int)(node->type & LN_TYPE_MASK) != type) return No;
+  if (type == LN_STRING && node->type & LN_BLOCK) return No;
+  return Yes;
+}
+
+LinkNode *_LLUpsertNode(LinkList *list, LinkNode *existing, LinkNode *node)
+{
+  if (!existing) return LLPush(list, node);
+
+  _LLReplaceNode(list, existing, node);
+  return node;
+}
+
+LinkNode *LLUpsertKeyedBoolean(LinkList *list, LLKey key, LLBoolean boolean)
+{
+  LinkNode *node = LLFindKeyed(list, key);
+
+  if (!_LLUpsertInPlace(node, LN_BOOLEAN))
+    return _LLUpsertNode(list, node, LNCreate(LNKBCreate(key, boolean), LN_BOOLEAN | LN_KEYED));
+
+  ((LLKeyedBool *)node->value)->boolean = boolean;
+  return node;
+}
+
+LinkNode *LLUpsertKeyedInteger(LinkList *list, LLKey key, MAX_INT_TYPE value, LLIntegerType type)
+{
+  LinkNode *node = LLFindKeyed(list, key);
+
+  if (!_LLUpsertInPlace(node, LN_INTEGER))
+    return _LLUpsertNode(list, node, LNCreate(LNKICreate(key, value, type), LN_INTEGER | LN_KEYED));
+
+  if (list->aggregates) _LLAggregateNode(list->aggregates, node, -1);
+  LNSetIntByType(&((LLKeyedInteger *)node->value)->integer, type, value);
+  if (list->aggregates) _LLAggregateNode(list->aggregates, node, 1);
+  return node;
+}
+
+LinkNode *LLUpsertKeyedDecimal(LinkList *list, LLKey key, MAX_DEC_TYPE value, LLDecimalType type)
 {
-  LLKeyedInteger *data = LNKICreate(key, value, type);
-  LinkNode *node = LNCreate(data, LN_INTEGER | LN_KEYED);
-  LLPush(list, node);
+  LinkNode *node = LLFindKeyed(list, key);
+
+  if (!_LLUpsertInPlace(node, LN_DECIMAL))
+    return _LLUpsertNode(list, node, LNCreate(LNKDCreate(key, value, type), LN_DECIMAL | LN_KEYED));
+
+  if (list->aggregates) _LLAggregateNode(list->aggregates, node, -1);
+  LNSetDecByType(&((LLKeyedDecimal *)node->value)->decimal, type, value);
+  if (list->aggregates) _LLAggregateNode(list->aggregates, node, 1);
   return node;
 }
 
-
-LinkNode *LLPushKeyedDecimal(LinkList *list, LLKey key, MAX_DEC_TYPE value, LLDecimalType type)
+LinkNode *LLUpsertKeyedString(LinkList *list, LLKey key, LLVoid string, LLStringType type)
 {
-  LLKeyedDecimal *data = LNKDCreate(key, value, type);
-  LinkNode *node = LNCreate(data, LN_DECIMAL | LN_KEYED);
-  LLPush(list, node);
-  return node;  
-}
+  LinkNode *node = LLFindKeyed(list, key);
+  LLStringNode *data;
+  char *old;
 
+  if (!_LLUpsertInPlace(node, LN_STRING))
+    return _LLUpsertNode(list, node, LNCreate(LNKSCreate(key, string, type), LN_STRING | LN_KEYED));
 
-LinkNode *LLPushKeyedString(LinkList *list, LLKey key, LLVoid string, LLStringType type)
-{
-  LLKeyedString *data = LNKSCreate(key, string, type);
-  LinkNode *node = LNCreate(data, LN_STRING | LN_KEYED);
-  LLPush(list, node);
-  return node;  
+  /* string may be the node's own buffer, so copy it before freeing that */
+  data = &((LLKeyedString *)node->value)->string;
+  old = data->u.s;
+  LNSetStrByType(data, type, string);
+  if (old) free(old);
+  return node;
 }
 
-
-LinkNode *LLPushKeyedVoid(LinkList *list, LLKey key, LLVoid value)
+LinkNode *LLUpsertKeyedVoid(LinkList *list, LLKey key, LLVoid data)
 {
-  LLKeyedVoid *data = LNKVCreate(key, value);
-  LinkNode *node = LNCreate(data, LN_VOID | LN_KEYED);
-  LLPush(list, node);
+  LinkNode *node = LLFindKeyed(list, key);
+  LLVoidNode *value;
+
+  if (!_LLUpsertInPlace(node, LN_VOID))
+    return _LLUpsertNode(list, node, LNCreate(LNKVCreate(key, data), LN_VOID | LN_KEYED));
+
+  /* The data index is keyed by the caller's pointer, which is changing */
+  value = &((LLKeyedVoid *)node->value)->voidNode;
+  if (list->dataIndex && value->value) LLIndexRemove(list->dataIndex, LLPointerHash(value->value), node);
+  value->value = data;
+  if (list->dataIndex && data) LLIndexInsert(list->dataIndex, LLPointerHash(data), node);
   return node;
 }
 
 #pragma mark - List Pop Functions
 
-LinkNode *LLPopNode(LinkList *list)
+LinkNode *_LLPopNode(LinkList *list)
 {
   LinkNode *node = list && list->tail ? list->tail : NULL;
 
   if (!node || !list) return NULL;
+  LL_STAT_ADD(list, pops[LLStatsTypeIndex(node->type)], 1);
   list->tail = node->prev;
 
-  if (list->head == node->prev) {
-  list->head = node->prev;
-  list->head->next = NULL;
-  list->head->prev = NULL;
-  }
+  if (list->tail) list->tail->next = NULL;
+  else list->head = NULL;
   
   node->next = NULL;
   node->prev = NULL;
   
+  _LLNodeDetached(list, node);
+  return node;
+}
+
+LinkNode *LLPopNode(LinkList *list)
+{
+  LinkNode *node = list ? list->tail : NULL;
+  LLBoolean traced = LL_TRACE_BEGIN(LL_TRACE_POP, list, node ? node->type : 0, _LLTraceKey(node));
+
+  node = _LLPopNode(list);
+  LL_TRACE_END(traced, LL_TRACE_POP, list, node ? node->type : 0, _LLTraceKey(node));
   return node;
 }
 
@@ -1160,22 +2692,31 @@ LLKeyedVoid *LLPopKeyedVoid(LinkList *list, LLKey key)
 
 #pragma mark - List Dequeue Functions
 
-LinkNode *LLDequeueNode(LinkList *list)
+LinkNode *_LLDequeueNode(LinkList *list)
 {
   LinkNode *node = list && list->head ? list->head : NULL;
 
   if (!node || !list) return NULL;
+  LL_STAT_ADD(list, dequeues[LLStatsTypeIndex(node->type)], 1);
   list->head = node->next;
-  list->head->prev = NULL;
 
-  if (list->tail == list->head) {
-    list->tail->next = NULL;
-    list->tail->prev = NULL;
-  }
+  if (list->head) list->head->prev = NULL;
+  else list->tail = NULL;
 
   node->next = NULL;
   node->prev = NULL;
 
+  _LLNodeDetached(list, node);
+  return node;
+}
+
+LinkNode *LLDequeueNode(LinkList *list)
+{
+  LinkNode *node = list ? list->head : NULL;
+  LLBoolean traced = LL_TRACE_BEGIN(LL_TRACE_DEQUEUE, list, node ? node->type : 0, _LLTraceKey(node));
+
+  node = _LLDequeueNode(list);
+  LL_TRACE_END(traced, LL_TRACE_DEQUEUE, list, node ? node->type : 0, _LLTraceKey(node));
   return node;
 }
 
@@ -1292,23 +2833,396 @@ LLKeyedVoid *LLDequeueKeyedVoid(LinkList *list, LLKey key)
 }
 
 
-#pragma mark - List Item Removal Functions
+#pragma mark - List Batch Pop and Dequeue Functions
 
-void LLRemoveNode(LinkList *list, LinkNode *node)
+/* Walks up to max nodes from one end, stopping early at a node whose base
+ * type is not type (0 takes any), and hands each to take before cutting
+ * the whole run loose with a single splice. The run keeps its inner links
+ * from the returned end node on; walk it with _LLRunNext. */
+LinkNode *_LLDetachRun(
+  LinkList *list,
+  LLBoolean fromTail,
+  int type,
+  size_t max,
+  void (*take)(LinkNode *node, size_t index, LLVoid out),
+  LLVoid out,
+  size_t *count
+)
 {
-  if (list->head == node) {
-  if (node->next) {
-    list->head = node->next;
+  LinkNode *first = fromTail ? list->tail : list->head, *node, *last = NULL;
+  size_t taken = 0;
+
+  for (node = first; node && taken < max; node = fromTail ? node->prev : node->next)
+  {
+    if (type && (int)(node->type & LN_TYPE_MASK) != type) break;
+
+    take(node, taken++, out);
+    if (fromTail) LL_STAT_ADD(list, pops[LLStatsTypeIndex(node->type)], 1);
+    else LL_STAT_ADD(list, dequeues[LLStatsTypeIndex(node->type)], 1);
+    _LLNodeDetached(list, node);
+    last = node;
   }
+
+  *count = taken;
+  if (!taken) return NULL;
+
+  if (fromTail)
+  {
+    list->tail = last->prev;
+    if (list->tail) list->tail->next = NULL;
+    else list->head = NULL;
+    last->prev = NULL;
   }
-  
-  if (list->tail == node) {
-  if (node->prev) 
+  else
+  {
+    list->head = last->next;
+    if (list->head) list->head->prev = NULL;
+    else list->tail = NULL;
+    last->next = NULL;
+  }
+
+  return first;
+}
+
+LinkNode *_LLRunNext(LinkNode *node, LLBoolean fromTail)
+{
+  return fromTail ? node->prev : node->next;
+}
+
+void _LLTakeNode(LinkNode *node, size_t index, LLVoid out)
+{
+  ((LinkNode **)out)[index] = node;
+}
+
+void _LLTakeBoolean(LinkNode *node, size_t index, LLVoid out)
+{
+  ((LLBoolean *)out)[index] = node->type & LN_KEYED
+    ? ((LLKeyedBool *)node->value)->boolean
+    : ((LLBoolNode *)node->value)->boolean;
+}
+
+void _LLTakeInteger(LinkNode *node, size_t index, LLVoid out)
+{
+  ((MAX_INT_TYPE *)out)[index] = LLIntegerValue(node->type & LN_KEYED
+    ? &((LLKeyedInteger *)node->value)->integer
+    : (LLIntegerNode *)node->value);
+}
+
+void _LLTakeDecimal(LinkNode *node, size_t index, LLVoid out)
+{
+  ((MAX_DEC_TYPE *)out)[index] = LLDecimalValue(node->type & LN_KEYED
+    ? &((LLKeyedDecimal *)node->value)->decimal
+    : (LLDecimalNode *)node->value);
+}
+
+/* Heap strings change hands; block strings live in the arena and are
+ * duplicated instead */
+void _LLTakeString(LinkNode *node, size_t index, LLVoid out)
+{
+  LLStringNode *string = node->type & LN_KEYED
+    ? &((LLKeyedString *)node->value)->string
+    : (LLStringNode *)node->value;
+
+  ((LLVoid *)out)[index] = string->u.s;
+
+  if (!(node->type & LN_BLOCK)) string->u.s = NULL;
+  #ifdef WCHAR_SUPPORT
+  else if (string->u.s && string->type == LLSN_WIDE) ((LLVoid *)out)[index] = __wstrdup(string->u.w);
+  #endif
+  else if (string->u.s) ((LLVoid *)out)[index] = __strdup(string->u.s);
+}
+
+void _LLTakeVoid(LinkNode *node, size_t index, LLVoid out)
+{
+  ((LLVoid *)out)[index] = LLNodeData(node);
+}
+
+size_t _LLTakeNodes(LinkList *list, LLBoolean fromTail, LinkNode **nodes, size_t max)
+{
+  size_t count, i;
+
+  _LLDetachRun(list, fromTail, 0, max, _LLTakeNode, nodes, &count);
+  for (i = 0; i < count; i++)
   {
-    list->tail = node->prev;
+    nodes[i]->next = NULL;
+    nodes[i]->prev = NULL;
   }
+
+  return count;
+}
+
+/* Copies values out of a run as it is detached, then frees its nodes */
+size_t _LLTakeValues(
+  LinkList *list,
+  LLBoolean fromTail,
+  int type,
+  void (*take)(LinkNode *node, size_t index, LLVoid out),
+  LLVoid out,
+  size_t max
+)
+{
+  LinkNode *node, *next;
+  size_t count;
+
+  node = _LLDetachRun(list, fromTail, type, max, take, out, &count);
+  for (; node; node = next)
+  {
+    next = _LLRunNext(node, fromTail);
+    LNDelete(node);
   }
-  
+
+  return count;
+}
+
+size_t LLPopNodes(LinkList *list, LinkNode **nodes, size_t max)
+{
+  return _LLTakeNodes(list, Yes, nodes, max);
+}
+
+size_t LLDequeueNodes(LinkList *list, LinkNode **nodes, size_t max)
+{
+  return _LLTakeNodes(list, No, nodes, max);
+}
+
+size_t LLPopBooleans(LinkList *list, LLBoolean *out, size_t max)
+{
+  return _LLTakeValues(list, Yes, LN_BOOLEAN, _LLTakeBoolean, out, max);
+}
+
+size_t LLPopIntegers(LinkList *list, MAX_INT_TYPE *out, size_t max)
+{
+  return _LLTakeValues(list, Yes, LN_INTEGER, _LLTakeInteger, out, max);
+}
+
+size_t LLPopDecimals(LinkList *list, MAX_DEC_TYPE *out, size_t max)
+{
+  return _LLTakeValues(list, Yes, LN_DECIMAL, _LLTakeDecimal, out, max);
+}
+
+size_t LLPopStrings(LinkList *list, LLVoid *out, size_t max)
+{
+  return _LLTakeValues(list, Yes, LN_STRING, _LLTakeString, out, max);
+}
+
+size_t LLPopVoids(LinkList *list, LLVoid *out, size_t max)
+{
+  return _LLTakeValues(list, Yes, LN_VOID, _LLTakeVoid, out, max);
+}
+
+size_t LLDequeueBooleans(LinkList *list, LLBoolean *out, size_t max)
+{
+  return _LLTakeValues(list, No, LN_BOOLEAN, _LLTakeBoolean, out, max);
+}
+
+size_t LLDequeueIntegers(LinkList *list, MAX_INT_TYPE *out, size_t max)
+{
+  return _LLTakeValues(list, No, LN_INTEGER, _LLTakeInteger, out, max);
+}
+
+size_t LLDequeueDecimals(LinkList *list, MAX_DEC_TYPE *out, size_t max)
+{
+  return _LLTakeValues(list, No, LN_DECIMAL, _LLTakeDecimal, out, max);
+}
+
+size_t LLDequeueStrings(LinkList *list, LLVoid *out, size_t max)
+{
+  return _LLTakeValues(list, No, LN_STRING, _LLTakeString, out, max);
+}
+
+size_t LLDequeueVoids(LinkList *list, LLVoid *out, size_t max)
+{
+  return _LLTakeValues(list, No, LN_VOID, _LLTakeVoid, out, max);
+}
+
+#pragma mark - List Splicing Functions
+
+/* Filters of one geometry merge by adding counters, saturating as before */
+LLBoolean _LLKeyFilterMerge(LLKeyFilter *filter, LLKeyFilter *from)
+{
+  unsigned int sum;
+  size_t i;
+
+  if (filter->size != from->size || filter->hashes != from->hashes) return No;
+
+  for (i = 0; i < filter->size; i++)
+  {
+    sum = (unsigned int)filter->counters[i] + from->counters[i];
+    filter->counters[i] = (unsigned char)(sum > 255 ? 255 : sum);
+  }
+
+  return Yes;
+}
+
+void _LLAggregatesMerge(LLAggregates *aggregates, LLAggregates *from)
+{
+  if (!from->count) return;
+  if (!aggregates->count)
+  {
+    *aggregates = *from;
+    return;
+  }
+
+  aggregates->count += from->count;
+  aggregates->integerSum += from->integerSum;
+  aggregates->decimalSum += from->decimalSum;
+  if (from->min < aggregates->min) aggregates->min = from->min;
+  if (from->max > aggregates->max) aggregates->max = from->max;
+  if (from->stale) aggregates->stale = Yes;
+}
+
+/* Carries all of src, about to be emptied into dst, across their indexes.
+ * Structures both lists keep are merged whole; dst only walks the nodes
+ * for the ones src lacks. */
+void _LLCarryAll(LinkList *dst, LinkList *src)
+{
+  LLBoolean filterMerged = No;
+  LLKeyedNode *keyed;
+  LLIntKeyed *intKeyed;
+  LinkNode *node;
+  LLVoid data;
+
+  #ifdef LL_STATS
+  LL_STAT_ADD(dst, allocations, src->stats.length);
+  LL_STAT_ADD(dst, bytesInUse, src->stats.bytesInUse);
+  LL_STAT_ADD(dst, length, src->stats.length);
+  if (dst->stats.length > dst->stats.peakLength) dst->stats.peakLength = dst->stats.length;
+  src->stats.bytesInUse = 0;
+  src->stats.length = 0;
+  #endif
+
+  dst->length += src->length;
+  src->length = 0;
+
+  if (src->aggregates && dst->aggregates) _LLAggregatesMerge(dst->aggregates, src->aggregates);
+  if (src->aggregates) memset(src->aggregates, 0L, sizeof(LLAggregates));
+
+  if (src->dataIndex && dst->dataIndex) _LLIndexMerge(dst->dataIndex, src->dataIndex);
+  else if (src->dataIndex) _LLIndexClear(src->dataIndex);
+
+  if (src->keyIndex && dst->keyIndex) _LLIndexMerge(dst->keyIndex, src->keyIndex);
+  else if (src->keyIndex) _LLIndexClear(src->keyIndex);
+
+  if (src->intKeyIndex && dst->intKeyIndex) _LLIndexMerge(dst->intKeyIndex, src->intKeyIndex);
+  else if (src->intKeyIndex) _LLIndexClear(src->intKeyIndex);
+
+  if (src->keyFilter && dst->keyFilter) filterMerged = _LLKeyFilterMerge(dst->keyFilter, src->keyFilter);
+  if (src->keyFilter) memset(src->keyFilter->counters, 0L, src->keyFilter->size);
+
+  if ((!dst->dataIndex || src->dataIndex) && (!dst->keyIndex || src->keyIndex) && (!dst->keyFilter || filterMerged)
+    && (!dst->intKeyIndex || src->intKeyIndex) && (!dst->aggregates || src->aggregates))
+    return;
+
+  for (node = src->head; node; node = node->next)
+  {
+    if (dst->aggregates && !src->aggregates) _LLAggregateNode(dst->aggregates, node, 1);
+
+    if (dst->dataIndex && !src->dataIndex && (data = LLNodeData(node)) != NULL)
+    {
+      LLIndexInsert(dst->dataIndex, LLPointerHash(data), node);
+    }
+
+    if (dst->intKeyIndex && !src->intKeyIndex && (intKeyed = LNIntKeyed(node)) != NULL)
+    {
+      LLIndexInsert(dst->intKeyIndex, LLIntKeyHash(intKeyed->key), node);
+    }
+
+    if ((keyed = _LLNodeKeyed(node)) == NULL) continue;
+
+    if (dst->keyIndex && !src->keyIndex) LLIndexInsert(dst->keyIndex, keyed->keyHash, node);
+    if (dst->keyFilter && !filterMerged) _LLKeyFilterCount(dst->keyFilter, keyed->keyHash, 1);
+  }
+}
+
+/* Carries the run first..last from src's indexes to dst's node by node */
+void _LLCarryRun(LinkList *dst, LinkList *src, LinkNode *first, LinkNode *last)
+{
+  LinkNode *node;
+
+  if (dst == src) return;
+
+  /* Lengths follow each node, so every run moved between lists is walked */
+  for (node = first; node; node = node->next)
+  {
+    _LLNodeDetached(src, node);
+    _LLNodeAttached(dst, node);
+    if (node == last) break;
+  }
+}
+
+void LLConcat(LinkList *dst, LinkList *src)
+{
+  if (!dst || !src || dst == src || !src->head) return;
+
+  _LLCarryAll(dst, src);
+
+  src->head->prev = dst->tail;
+  if (dst->tail) dst->tail->next = src->head;
+  else dst->head = src->head;
+  dst->tail = src->tail;
+
+  src->head = NULL;
+  src->tail = NULL;
+}
+
+void LLSplice(LinkList *dst, LinkNode *pos, LinkList *src, LinkNode *first, LinkNode *last)
+{
+  LinkNode *next;
+
+  if (!dst || !src || !first || !last) return;
+
+  _LLCarryRun(dst, src, first, last);
+
+  if (first->prev) first->prev->next = last->next;
+  else src->head = last->next;
+  if (last->next) last->next->prev = first->prev;
+  else src->tail = first->prev;
+
+  next = pos ? pos->next : dst->head;
+  first->prev = pos;
+  last->next = next;
+
+  if (pos) pos->next = first;
+  else dst->head = first;
+  if (next) next->prev = last;
+  else dst->tail = last;
+}
+
+LinkList *LLSplitAt(LinkList *list, LinkNode *node)
+{
+  LinkList *rest = LLCreate();
+  LinkNode *first;
+
+  if (!rest) return NULL;
+
+  /* The new list keeps the same indexes, filter geometry included */
+  if (list->dataIndex) LLEnableDataIndex(rest, Yes);
+  if (list->keyIndex) LLEnableKeyIndex(rest, Yes);
+  if (list->intKeyIndex) LLEnableIntKeyIndex(rest, Yes);
+  if (list->keyFilter) LLEnableKeyFilter(rest, Yes, list->keyFilter->size / 10);
+  if (list->aggregates) LLEnableAggregates(rest, Yes);
+
+  /* Keys must keep matching, and staying unique, the same way once they
+   * move; the nodes moved are already free of duplicates */
+  rest->caseSensitiveKeys = list->caseSensitiveKeys;
+  rest->uniqueKeys = list->uniqueKeys;
+
+  first = node ? node->next : list->head;
+  if (first == list->head) LLConcat(rest, list);
+  else if (first) LLSplice(rest, NULL, list, first, list->tail);
+
+  return rest;
+}
+
+#pragma mark - List Item Removal Functions
+
+void _LLRemoveNode(LinkList *list, LinkNode *node)
+{
+  if (!list || !node) return;
+  LL_STAT_ADD(list, removals, 1);
+
+  if (list->head == node) list->head = node->next;
+  if (list->tail == node) list->tail = node->prev;
+
   if (node->prev) 
   {
   node->prev->next = node->next;
@@ -1318,6 +3232,19 @@ void LLRemoveNode(LinkList *list, LinkNode *node)
   {
   node->next->prev = node->prev;
   }
+
+  node->next = NULL;
+  node->prev = NULL;
+
+  _LLNodeDetached(list, node);
+}
+
+void LLRemoveNode(LinkList *list, LinkNode *node)
+{
+  LLBoolean traced = LL_TRACE_BEGIN(LL_TRACE_REMOVE, list, node ? node->type : 0, _LLTraceKey(node));
+
+  _LLRemoveNode(list, node);
+  LL_TRACE_END(traced, LL_TRACE_REMOVE, list, node ? node->type : 0, _LLTraceKey(node));
 }
 
 
@@ -1327,24 +3254,77 @@ void LLRemoveByKey(LinkList *list, LLKey key)
   LLRemoveNode(list, node);
 }
 
+void LLRemoveByIntKey(LinkList *list, LLIntKey key)
+{
+  LinkNode *node = LLFindIntKeyed(list, key);
+  LLRemoveNode(list, node);
+}
+
 
 void LLRemoveByData(LinkList *list, LLVoid data)
 {
   LinkNode *node = list && list->head ? list->head : NULL;
   LinkNode *inspect;
+
+  if (!data) return;
+
+  if (list && list->dataIndex)
+  {
+  while ((inspect = LLFindByData(list, data)) != NULL)
+  {
+    LLRemoveNode(list, inspect);
+  }
+  return;
+  }
   
   while (node) 
   {
   inspect = node;
+  node = node->next;
   
-  if (inspect->value && inspect->value == data) {
+  if (LLNodeData(inspect) == data) {
     LLRemoveNode(list, inspect);
   }
-  
-  node = node->next;
   }
 }
 
+#pragma mark - List Membership Functions
+
+LinkNode *LLFindByData(LinkList *list, LLVoid data)
+{
+  LinkNode *node = list && list->head ? list->head : NULL;
+  LLIndexEntry *entry;
+  unsigned long hash;
+
+  if (!data) return NULL;
+
+  if (list && list->dataIndex)
+  {
+    hash = LLPointerHash(data);
+    for (entry = LLIndexFirst(list->dataIndex, hash); entry; entry = entry->next)
+    {
+      if (entry->hash == hash && LLNodeData(entry->node) == data)
+      {
+        return entry->node;
+      }
+    }
+    return NULL;
+  }
+
+  while (node)
+  {
+    if (LLNodeData(node) == data) return node;
+    node = node->next;
+  }
+
+  return NULL;
+}
+
+LLBoolean LLContainsData(LinkList *list, LLVoid data)
+{
+  return LLFindByData(list, data) ? Yes : No;
+}
+
 #pragma mark - Link List "Instance" Methods
 
 /* Push methods without keyed or named values */
@@ -1642,7 +3622,7 @@ char *_LLPopKString(struct LinkList *list, LLKey key)
 
 LLVoid _LLPopKVoid(struct LinkList *list, LLKey key)
 {
-  return LLPopKeyedVoid(list, key)->voidNode->value;
+  return LLPopKeyedVoid(list, key)->voidNode.value;
 }
 
 
@@ -1781,7 +3761,7 @@ char *_LLDequeueKString(struct LinkList *list, LLKey key)
 
 LLVoid _LLDequeueKVoid(struct LinkList *list, LLKey key)
 {
-  return LLDequeueKeyedVoid(list, key)->voidNode->value;
+  return LLDequeueKeyedVoid(list, key)->voidNode.value;
 }
 
 
@@ -8,6 +8,10 @@
 #include <stdio.h>
 #include <stddef.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #pragma mark - Base Types
 
 /** Base type for generic data pointers for anything going forward. */
@@ -36,6 +40,9 @@ typedef size_t LLHashLimit;
 #define MAX_DEC_TYPE long double
 #endif
 
+/** Integer keys are the widest integer type, so 64-bit ids fit on LP64 */
+typedef MAX_INT_TYPE LLIntKey;
+
 #pragma mark - Enums
 
 typedef enum
@@ -84,9 +91,31 @@ typedef enum
   LN_STRING = 8,
   LN_VOID = 16,
 
-  LN_KEYED = 256
+  LN_KEYED = 256,
+
+  /** Node and value were carved from an LLNodeBlock; see LLBlockNode */
+  LN_BLOCK = 512,
+
+  /** Value is an LLIntKeyed; see LLPushIntKeyedInteger and friends */
+  LN_INT_KEYED = 1024
 } LinkNodeDataType;
 
+/** The bits of LinkNode.type naming its data; LN_KEYED, LN_BLOCK and
+ * LN_INT_KEYED are flags above them, so compare data types as
+ * (type & LN_TYPE_MASK) */
+#define LN_TYPE_MASK 255
+
+/** Operations reported to trace hooks and USDT probes */
+typedef enum
+{
+  LL_TRACE_PUSH = 1,
+  LL_TRACE_POP = 2,
+  LL_TRACE_DEQUEUE = 3,
+  LL_TRACE_FIND_KEYED = 4,
+  LL_TRACE_REMOVE = 5,
+  LL_TRACE_DELETE = 6
+} LLTraceOp;
+
 typedef enum
 {
   LL_FORWARD = 1,
@@ -99,6 +128,13 @@ typedef struct LLKeyedNode
 {
   LLKey key;
   unsigned int hashValue;
+
+  /** strlen(key), screened before any key comparison */
+  unsigned int keyLength;
+
+  /** Case folded LLKeyHash() of key; compared before any key and used by
+   * the list key index */
+  unsigned long keyHash;
 } LLKeyedNode;
 
 typedef struct LLBoolNode
@@ -182,10 +218,27 @@ typedef struct LLVoidNode
 
 typedef struct LLKeyedVoid
 {
-  LLKeyedNode *keyedNode;
-  LLVoidNode *voidNode;
+  LLKeyedNode keyedNode;
+  LLVoidNode voidNode;
 } LLKeyedVoid;
 
+/** Value of an LN_INT_KEYED node. The data leads, laid out as the value
+ * of an unkeyed node of the same type, so anything reading unkeyed values
+ * reads these too; the key follows it. Keys are compared as integers and
+ * never formatted, copied or case folded. */
+typedef struct LLIntKeyed
+{
+  union
+  {
+    LLBoolNode b;
+    LLIntegerNode i;
+    LLDecimalNode d;
+    LLStringNode s;
+    LLVoidNode v;
+  } u;
+  LLIntKey key;
+} LLIntKeyed;
+
 typedef struct LinkNode
 {
   struct LinkNode *next;
@@ -194,11 +247,157 @@ typedef struct LinkNode
   LinkNodeDataType type;
 } LinkNode;
 
+/** Header of a single allocation holding many LLBlockNodes followed by
+ * an arena for their keys and strings. It is freed with its last node. */
+typedef union LLNodeBlock
+{
+  size_t live;
+  MAX_DEC_TYPE alignment;
+} LLNodeBlock;
+
+/** A node whose value sits in the same slot and whose key and string, if
+ * any, sit in its block's arena. LNDelete hands the slot back instead of
+ * freeing the parts, so none of them may be swapped for heap pointers. */
+typedef struct LLBlockNode
+{
+  LinkNode link;
+  LLNodeBlock *block;
+  union
+  {
+    LLBoolNode b;
+    LLIntegerNode i;
+    LLDecimalNode d;
+    LLStringNode s;
+    LLVoidNode v;
+    LLKeyedBool kb;
+    LLKeyedInteger ki;
+    LLKeyedDecimal kd;
+    LLKeyedString ks;
+    LLKeyedVoid kv;
+  } u;
+} LLBlockNode;
+
+/** A single node reference stored in an LLIndex bucket chain */
+typedef struct LLIndexEntry
+{
+  struct LLIndexEntry *next;
+  LinkNode *node;
+  unsigned long hash;
+} LLIndexEntry;
+
+/** Chained hash table mapping precomputed hash values to list nodes. The
+ * index does not know what was hashed; callers verify each candidate. */
+typedef struct LLIndex
+{
+  LLIndexEntry **buckets;
+
+  /* Last entry of each chain, sharing the buckets allocation, so appends
+   * that keep chains in insertion order take constant time */
+  LLIndexEntry **tails;
+  size_t bucketCount;
+  size_t count;
+} LLIndex;
+
+/** Counting Bloom filter over the keys in a list. Counters saturate at
+ * 255 and then stay set, so removals can never cause a false negative. */
+typedef struct LLKeyFilter
+{
+  unsigned char *counters;
+  size_t size;
+  int hashes;
+
+  unsigned long queries;
+  unsigned long negatives;
+  unsigned long falsePositives;
+} LLKeyFilter;
+
+typedef struct LLKeyFilterStats
+{
+  unsigned long queries;        /* keyed lookups that consulted the filter */
+  unsigned long negatives;      /* lookups answered without touching a node */
+  unsigned long falsePositives; /* lookups the filter passed that then missed */
+  double falsePositiveRate;     /* observed falsePositives / all misses */
+  double expectedRate;          /* chance an absent key passes right now */
+} LLKeyFilterStats;
+
+/* Data types LLStats counts separately; see LLStatsTypeIndex */
+#define LL_STATS_TYPES 6
+
+/** Counters kept per list when built with LL_STATS, read with LLGetStats.
+ * Every translation unit must agree on LL_STATS since it changes the size
+ * of LinkList. With LL_STATS_ATOMIC as well the counters are bumped with
+ * relaxed atomic adds so lists shared between threads stay accurate. */
+typedef struct LLStats
+{
+  /* Operations by data type */
+  unsigned long pushes[LL_STATS_TYPES];
+  unsigned long pops[LL_STATS_TYPES];
+  unsigned long dequeues[LL_STATS_TYPES];
+  unsigned long removals;
+
+  /* Keyed lookups through LLFindKeyed */
+  unsigned long lookups;
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long nodesVisited;  /* list nodes or index entries examined */
+  unsigned long keyCompares;   /* keys compared past the hash and length */
+
+  /* Node memory, sized as a LinkNode plus LLDataSize() */
+  unsigned long allocations;   /* nodes the list has taken on */
+  unsigned long bytesInUse;
+  unsigned long length;
+  unsigned long peakLength;
+} LLStats;
+
+/** Running totals over the LN_INTEGER and LN_DECIMAL nodes of a list with
+ * LLEnableAggregates on. Values are read as nodes join and leave the list,
+ * so a number changed in place other than by an LLUpsertKeyed function is
+ * not seen until the aggregates are enabled again. */
+typedef struct LLAggregates
+{
+  unsigned long count;      /* numeric nodes in the list */
+  MAX_INT_TYPE integerSum;  /* over LN_INTEGER nodes */
+  MAX_DEC_TYPE decimalSum;  /* over LN_DECIMAL nodes */
+  MAX_DEC_TYPE min;
+  MAX_DEC_TYPE max;
+
+  /* A node holding min or max has left; both are rescanned when next read */
+  LLBoolean stale;
+} LLAggregates;
+
 typedef struct LinkList
 {
   LinkNode *head;
   LinkNode *tail;
 
+  /* Nodes in the list, kept as they are attached and detached */
+  unsigned long length;
+
+  /* Optional numeric totals; see LLEnableAggregates */
+  LLAggregates *aggregates;
+
+  /* Optional reverse index from data pointers to nodes; see LLEnableDataIndex */
+  LLIndex *dataIndex;
+
+  /* Optional index of keyed nodes by LLKeyHash(); see LLEnableKeyIndex */
+  LLIndex *keyIndex;
+
+  /* Optional index of LN_INT_KEYED nodes by LLIntKeyHash(); see LLEnableIntKeyIndex */
+  LLIndex *intKeyIndex;
+
+  /* Optional filter letting keyed lookup misses skip the search entirely */
+  LLKeyFilter *keyFilter;
+
+  /* Keyed pushes replace any node with the same key; see LLEnableUniqueKeys */
+  LLBoolean uniqueKeys;
+
+  /* Keys match exactly rather than ignoring ASCII case; see LLEnableCaseSensitiveKeys */
+  LLBoolean caseSensitiveKeys;
+
+  #ifdef LL_STATS
+  LLStats stats;
+  #endif
+
   /* Push methods without keyed or named values */
   struct LinkList *(*pushBool)(struct LinkList *list, LLBoolean data);
   struct LinkList *(*pushChar)(struct LinkList *list, char data);
@@ -320,6 +519,12 @@ typedef struct LinkList
   #endif
 } LinkList;
 
+/** Trace callback. type and key describe the node involved, when known:
+ * pops and dequeues report the node about to leave at begin. The list
+ * passed to the end of LL_TRACE_DELETE has already released its nodes and
+ * indexes and is freed once the callback returns. */
+typedef void (*LLTraceFn)(LLTraceOp op, LinkList *list, int type, LLKey key, LLVoid context);
+
 /** ForEach function pointer type */
 typedef LLVoid (*LLMapFn)(LLVoid data, size_t index, LinkList *list);
 typedef void (*LLForEach)(LLVoid data, size_t index, LinkList *list);
@@ -328,6 +533,29 @@ typedef LinkList *(*LLMap)(LLMapFn mapFn, LinkList *list);
 #pragma mark - Constant Exports
 
 unsigned int LLDefaultStringHashFn(LLKey key, int limit);
+unsigned long LLKeyHash(LLKey key);
+unsigned long LLIntKeyHash(LLIntKey key);
+
+/** LLKeyHash of a string literal, folded to a constant by the compiler for
+ * literals of up to LL_KEY_HASH_MAX characters; longer ones are hashed at
+ * run time. Pass it to LLFindKeyedHashed, or use LL_FIND_KEYED_LITERAL.
+ * Arrays and pointers fail to compile, as their sizes are not the key's. */
+#define LL_KEY_HASH_MAX 32
+#define LL_KEY_HASH(literal) _LL_KEY_HASH_OF("" literal "")
+
+/* s is a literal pasted between empty ones, so sizeof(s) is its length + 1.
+ * One FNV-1a step per byte; past the literal's end a step multiplies by 1 */
+#define _LL_KEY_HASH_OF(s) (sizeof(s) > LL_KEY_HASH_MAX + 1 \
+  ? LLKeyHash((LLKey)(s)) \
+  : _LL_KEY_HASH16(_LL_KEY_HASH16(2166136261UL, s, 0), s, 16))
+#define _LL_KEY_AT(s, i) ((unsigned long)(unsigned char)(s)[(i) < sizeof(s) ? (i) : 0])
+#define _LL_KEY_FOLD(c) ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))
+#define _LL_KEY_STEP(h, s, i) ((((h) ^ ((i) < sizeof(s) - 1 ? _LL_KEY_FOLD(_LL_KEY_AT(s, i)) : 0UL)) \
+  * ((i) < sizeof(s) - 1 ? 16777619UL : 1UL)) & 0xffffffffUL)
+#define _LL_KEY_HASH4(h, s, i) \
+  _LL_KEY_STEP(_LL_KEY_STEP(_LL_KEY_STEP(_LL_KEY_STEP(h, s, i), s, (i) + 1), s, (i) + 2), s, (i) + 3)
+#define _LL_KEY_HASH16(h, s, i) \
+  _LL_KEY_HASH4(_LL_KEY_HASH4(_LL_KEY_HASH4(_LL_KEY_HASH4(h, s, i), s, (i) + 4), s, (i) + 8), s, (i) + 12)
 
 extern const LLHashFn LLDefaultHashFunction;
 extern const LLHashLimit LLDefaultHashLimit;
@@ -335,9 +563,117 @@ extern const LLHashLimit LLDefaultHashLimit;
 #pragma mark - Utility Functions
 
 size_t LLDataSize(LinkNode *node);
+LLVoid LLNodeData(LinkNode *node);
+MAX_INT_TYPE LLIntegerValue(LLIntegerNode *node);
+MAX_DEC_TYPE LLDecimalValue(LLDecimalNode *node);
+void LNSetIntByType(LLIntegerNode *node, LLIntegerType type, MAX_INT_TYPE value);
+void LNSetDecByType(LLDecimalNode *node, LLDecimalType type, MAX_DEC_TYPE value);
 LinkNode *LLFindKeyed(LinkList *list, LLKey key);
+
+/** As LLFindKeyed with hash already known to be LLKeyHash(key), so the
+ * key need not be hashed again before the search */
+LinkNode *LLFindKeyedHashed(LinkList *list, LLKey key, unsigned long hash);
+#define LL_FIND_KEYED_LITERAL(list, literal) \
+  LLFindKeyedHashed(list, (LLKey)("" literal ""), LL_KEY_HASH(literal))
+
+/** Returns node's LLIntKeyed value, or NULL unless it is LN_INT_KEYED */
+LLIntKeyed *LNIntKeyed(LinkNode *node);
+
+/** Returns the earliest pushed LN_INT_KEYED node holding key, or NULL */
+LinkNode *LLFindIntKeyed(LinkList *list, LLIntKey key);
+
 LLStringNode *LLDuplicateStringNode(LLStringNode *source);
 LinkNode *LLFindNodeOfType(LinkList *list, LinkNodeDataType type, LLFindDir dir);
+LinkNode *LLMoveNodeToTail(LinkList *list, LinkNode *node);
+
+#pragma mark - Index Functions
+
+LLIndex *LLIndexCreate(size_t bucketCount);
+void LLIndexDelete(LLIndex *index);
+void LLIndexInsert(LLIndex *index, unsigned long hash, LinkNode *node);
+LLBoolean LLIndexRemove(LLIndex *index, unsigned long hash, LinkNode *node);
+LLIndexEntry *LLIndexFirst(LLIndex *index, unsigned long hash);
+unsigned long LLPointerHash(LLVoid pointer);
+
+/** Maintains a pointer keyed index of LLNodeData() for every node in the
+ * list so LLFindByData and LLRemoveByData run in constant time. Enabling
+ * indexes the nodes already present; disabling frees the index. */
+LLBoolean LLEnableDataIndex(LinkList *list, LLBoolean enable);
+
+/** Maintains a hash index of every keyed node so LLFindKeyed, and all of
+ * the keyed pop and dequeue functions built on it, avoid a full scan. When
+ * a key appears more than once the earliest pushed node is found. */
+LLBoolean LLEnableKeyIndex(LinkList *list, LLBoolean enable);
+
+/** As LLEnableKeyIndex for the integer keys of LN_INT_KEYED nodes, hashed
+ * with LLIntKeyHash, so LLFindIntKeyed avoids a full scan */
+LLBoolean LLEnableIntKeyIndex(LinkList *list, LLBoolean enable);
+
+/** Maintains a counting Bloom filter over the keys in the list, sized for
+ * expectedKeys at roughly a 1% false positive rate. Keyed lookups for keys
+ * the filter rules out return before any key comparison. */
+LLBoolean LLEnableKeyFilter(LinkList *list, LLBoolean enable, size_t expectedKeys);
+LLBoolean LLKeyFilterMayContain(LLKeyFilter *filter, unsigned long keyHash);
+void LLGetKeyFilterStats(LinkList *list, LLKeyFilterStats *stats);
+
+/** Keyed lookups on the list compare keys exactly while enabled, and
+ * ignoring ASCII case, the default, otherwise. Either way a candidate is
+ * compared only once its stored hash and length match. Turning it off
+ * with unique keys on deletes the keys that now repeat, as enabling
+ * LLEnableUniqueKeys does. */
+LLBoolean LLEnableCaseSensitiveKeys(LinkList *list, LLBoolean enable);
+
+#pragma mark - Length and Aggregate Functions
+
+/** Returns the number of nodes in the list without walking it */
+unsigned long LLLength(LinkList *list);
+
+/** Keeps count, sums, min and max of the list's numeric nodes as they are
+ * pushed and removed. Enabling totals the nodes already present; disabling
+ * frees the aggregates. */
+LLBoolean LLEnableAggregates(LinkList *list, LLBoolean enable);
+
+/** Copies the list's aggregates into aggregates and returns Yes, or zeroes
+ * them and returns No when they are not enabled. If min or max was removed
+ * since the last read, the list is walked once to find the new ones. */
+LLBoolean LLGetAggregates(LinkList *list, LLAggregates *aggregates);
+
+#pragma mark - Statistics Functions
+
+/** Maps a LinkNodeDataType to its slot in the LLStats per type arrays */
+int LLStatsTypeIndex(int type);
+
+/** Copies the list's counters into stats and returns Yes, or zeroes stats
+ * and returns No when the library was built without LL_STATS */
+LLBoolean LLGetStats(LinkList *list, LLStats *stats);
+
+/** Zeroes the operation counters; length and memory in use are kept */
+void LLResetStats(LinkList *list);
+
+#pragma mark - Tracing Functions
+
+/** Installs process wide callbacks fired around LLPush, LLPopNode,
+ * LLDequeueNode, LLFindKeyed, LLRemoveNode and LLDelete. Only one in every
+ * sampleEvery operations is reported (0 or 1 reports all), and an
+ * operation reported at begin is always reported at end. NULL callbacks
+ * turn tracing off, leaving a single branch per operation.
+ *
+ * Built with LL_USDT, the same points are also USDT probes, provider
+ * clinklist, named op_begin and op_end with arguments (op, list, type,
+ * key). They ignore sampling and cost a no-op until a tracer attaches. */
+void LLSetTraceHooks(LLTraceFn begin, LLTraceFn end, unsigned long sampleEvery, LLVoid context);
+
+#pragma mark - Block Allocation Functions
+
+/** Allocates count nodes and arenaSize arena bytes with a single malloc.
+ * Each slot comes back typed LN_BLOCK with its value pointing at its own
+ * union; set the data type bits, fill the value and push it. Slots left
+ * unused must still be handed back with LNDelete. */
+LLBlockNode *LLNodeBlockCreate(size_t count, size_t arenaSize, char **arena);
+
+/** Points node at key without copying it and fills in its length and both
+ * key hashes */
+void LNKSetKey(LLKeyedNode *node, LLKey key);
 
 #pragma mark - Initialization Functions
 
@@ -374,6 +710,9 @@ LLKeyedDecimal *LNKDCreate(LLKey key, MAX_DEC_TYPE value, LLDecimalType type);
 LLKeyedString *LNKSCreate(LLKey key, LLVoid string, LLStringType type);
 LLKeyedVoid *LNKVCreate(LLKey key, LLVoid data);
 
+/** Returns a zeroed LLIntKeyed holding key; fill in one member of u */
+LLIntKeyed *LNIKCreate(LLIntKey key);
+
 #pragma mark - Deallocation Functions
 
 void LLDelete(LinkList *list);
@@ -395,6 +734,57 @@ LinkNode *LLPushKeyedDecimal(LinkList *list, LLKey key, MAX_DEC_TYPE value, LLDe
 LinkNode *LLPushKeyedString(LinkList *list, LLKey key, LLVoid string, LLStringType type);
 LinkNode *LLPushKeyedVoid(LinkList *list, LLKey key, LLVoid data);
 
+/* Push LN_INT_KEYED nodes, found again with LLFindIntKeyed. Their values
+ * read like those of unkeyed nodes, so the unkeyed pop, dequeue and batch
+ * functions take them as well. LLSerialize and LLImage keep their keys;
+ * the JSON writers refuse lists holding them. */
+LinkNode *LLPushIntKeyedBoolean(LinkList *list, LLIntKey key, LLBoolean boolean);
+LinkNode *LLPushIntKeyedInteger(LinkList *list, LLIntKey key, MAX_INT_TYPE value, LLIntegerType type);
+LinkNode *LLPushIntKeyedDecimal(LinkList *list, LLIntKey key, MAX_DEC_TYPE value, LLDecimalType type);
+LinkNode *LLPushIntKeyedString(LinkList *list, LLIntKey key, LLVoid string, LLStringType type);
+LinkNode *LLPushIntKeyedVoid(LinkList *list, LLIntKey key, LLVoid data);
+
+#pragma mark - List Batch Push Functions
+
+/** Links count block nodes to each other in order and splices the run
+ * onto the list's tail; returns the first node */
+LinkNode *LLPushBlock(LinkList *list, LLBlockNode *nodes, size_t count);
+
+/* Push count values from an array as a run of nodes carved from a single
+ * LLNodeBlock, which also holds copies of any strings and keys. Keys come
+ * from a parallel array; runs of the same key pointer share one copy.
+ * Each returns the first node pushed, or NULL if nothing was pushed, as
+ * when any entry of a key array is NULL. */
+LinkNode *LLPushBooleans(LinkList *list, const LLBoolean *values, size_t count);
+LinkNode *LLPushIntegers(LinkList *list, const MAX_INT_TYPE *values, size_t count, LLIntegerType type);
+LinkNode *LLPushDecimals(LinkList *list, const MAX_DEC_TYPE *values, size_t count, LLDecimalType type);
+LinkNode *LLPushStrings(LinkList *list, const LLVoid *strings, size_t count, LLStringType type);
+LinkNode *LLPushVoids(LinkList *list, const LLVoid *values, size_t count);
+
+LinkNode *LLPushKeyedBooleans(LinkList *list, const LLKey *keys, const LLBoolean *values, size_t count);
+LinkNode *LLPushKeyedIntegers(LinkList *list, const LLKey *keys, const MAX_INT_TYPE *values, size_t count, LLIntegerType type);
+LinkNode *LLPushKeyedDecimals(LinkList *list, const LLKey *keys, const MAX_DEC_TYPE *values, size_t count, LLDecimalType type);
+LinkNode *LLPushKeyedStrings(LinkList *list, const LLKey *keys, const LLVoid *strings, size_t count, LLStringType type);
+LinkNode *LLPushKeyedVoids(LinkList *list, const LLKey *keys, const LLVoid *values, size_t count);
+
+#pragma mark - List Upsert Functions
+
+/** While enabled, pushing a keyed node puts it in place of the node that
+ * already holds its key, which is deleted; integer keys are matched with
+ * integer keys. Enabling turns on both key indexes so each check is
+ * constant time, and deletes all but the newest node of any key already
+ * repeated. Splicing lists together does not check. */
+LLBoolean LLEnableUniqueKeys(LinkList *list, LLBoolean enable);
+
+/* Each sets the value of the first node holding key, reusing the node
+ * where its type allows and otherwise replacing it in position, or pushes
+ * a new node when key is absent. Returns the node now holding the value. */
+LinkNode *LLUpsertKeyedBoolean(LinkList *list, LLKey key, LLBoolean boolean);
+LinkNode *LLUpsertKeyedInteger(LinkList *list, LLKey key, MAX_INT_TYPE value, LLIntegerType type);
+LinkNode *LLUpsertKeyedDecimal(LinkList *list, LLKey key, MAX_DEC_TYPE value, LLDecimalType type);
+LinkNode *LLUpsertKeyedString(LinkList *list, LLKey key, LLVoid string, LLStringType type);
+LinkNode *LLUpsertKeyedVoid(LinkList *list, LLKey key, LLVoid data);
+
 #pragma mark - List Pop Functions
 
 LinkNode *LLPopNode(LinkList *list);
@@ -425,10 +815,61 @@ LLKeyedDecimal *LLDequeueKeyedDecimal(LinkList *list, LLKey key);
 LLKeyedString *LLDequeueKeyedString(LinkList *list, LLKey key);
 LLKeyedVoid *LLDequeueKeyedVoid(LinkList *list, LLKey key);
 
+#pragma mark - List Batch Pop and Dequeue Functions
+
+/** Detaches up to max nodes from the tail (pop) or head (dequeue) with a
+ * single splice and stores them in the order taken; returns how many */
+size_t LLPopNodes(LinkList *list, LinkNode **nodes, size_t max);
+size_t LLDequeueNodes(LinkList *list, LinkNode **nodes, size_t max);
+
+/* Take up to max nodes of one type from the tail or head, copy their
+ * values into out in the order taken and free the nodes; keyed nodes give
+ * up their values too. A node of another type ends the run and stays put.
+ * Strings are handed over and must be released with free(). Each returns
+ * the number of values copied. */
+size_t LLPopBooleans(LinkList *list, LLBoolean *out, size_t max);
+size_t LLPopIntegers(LinkList *list, MAX_INT_TYPE *out, size_t max);
+size_t LLPopDecimals(LinkList *list, MAX_DEC_TYPE *out, size_t max);
+size_t LLPopStrings(LinkList *list, LLVoid *out, size_t max);
+size_t LLPopVoids(LinkList *list, LLVoid *out, size_t max);
+
+size_t LLDequeueBooleans(LinkList *list, LLBoolean *out, size_t max);
+size_t LLDequeueIntegers(LinkList *list, MAX_INT_TYPE *out, size_t max);
+size_t LLDequeueDecimals(LinkList *list, MAX_DEC_TYPE *out, size_t max);
+size_t LLDequeueStrings(LinkList *list, LLVoid *out, size_t max);
+size_t LLDequeueVoids(LinkList *list, LLVoid *out, size_t max);
+
+#pragma mark - List Splicing Functions
+
+/** Moves every node of src onto the end of dst, leaving src empty. The
+ * relink is constant time; when both lists keep the same index or an
+ * equally sized key filter it is merged whole without reallocating. */
+void LLConcat(LinkList *dst, LinkList *src);
+
+/** Moves the run first..last out of src to follow pos in dst, or to the
+ * front of dst when pos is NULL. first must not come after last, and pos
+ * must not lie inside the run. Between two lists the run is walked once
+ * to carry its length and any indexes or aggregates. */
+void LLSplice(LinkList *dst, LinkNode *pos, LinkList *src, LinkNode *first, LinkNode *last);
+
+/** Cuts list after node, or before its head when node is NULL, moving
+ * the rest into a new list that keeps the same indexes */
+LinkList *LLSplitAt(LinkList *list, LinkNode *node);
+
 #pragma mark - List Item Removal Functions
 
 void LLRemoveNode(LinkList *list, LinkNode *node);
 void LLRemoveByKey(LinkList *list, LLKey key);
+void LLRemoveByIntKey(LinkList *list, LLIntKey key);
 void LLRemoveByData(LinkList *list, LLVoid data);
 
+#pragma mark - List Membership Functions
+
+LinkNode *LLFindByData(LinkList *list, LLVoid data);
+LLBoolean LLContainsData(LinkList *list, LLVoid data);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
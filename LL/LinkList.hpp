@@ -0,0 +1,541 @@
+#ifndef LINKED_LIST_HPP
+#define LINKED_LIST_HPP
+
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "LinkList.h"
+#include "LinkListInline.h"
+
+/* Header only C++11 wrapper over the C core.
+ *
+ * ll::List owns a LinkList, deleting it with LLDelete, and moves but does
+ * not copy. push, pop and dequeue are templates resolved through
+ * ll::traits<T> at compile time, so scalars go straight to the typed
+ * LinkListInline.h functions with no LLIntegerType or node type switch.
+ * ll::KeyedList<T> adds keyed push, upsert, lookup and erase of one value
+ * type. Iterators walk the LinkNodes; ll::value<T>(node) reads one back.
+ *
+ * Strings, and keys pushed through the wrapper, are copied once into a
+ * single allocation with their node (an LN_BLOCK node whose arena holds
+ * the bytes) instead of being duplicated per part. A std::string cannot
+ * surrender its buffer, so moving one in costs that same single copy.
+ * Strings stop at their first NUL, as everywhere else in the library. */
+
+namespace ll
+{
+  #pragma mark - Node Helpers
+
+  namespace detail
+  {
+    /* One allocation holding the node and extra arena bytes */
+    inline LLBlockNode *block(int type, size_t extra, char **arena)
+    {
+      LLBlockNode *node = LLNodeBlockCreate(1, extra, arena);
+      if (!node) throw std::bad_alloc();
+      node->link.type = (LinkNodeDataType)(node->link.type | type);
+      return node;
+    }
+
+    /* As block, with key copied to the front of the arena and set */
+    inline LLBlockNode *keyedBlock(int type, const char *key, size_t extra, char **arena)
+    {
+      size_t length = std::strlen(key) + 1;
+      LLBlockNode *node = block(type | LN_KEYED, length + extra, arena);
+
+      std::memcpy(*arena, key, length);
+      LNKSetKey(&node->u.kb.keyedNode, *arena);
+      *arena += length;
+      return node;
+    }
+
+    inline LinkNode *push(LinkList *list, LLBlockNode *node)
+    {
+      return LLPush(list, &node->link);
+    }
+
+    inline LLStringNode *stringNode(const LinkNode *node)
+    {
+      return node->type & LN_KEYED ? &((LLKeyedString *)node->value)->string : (LLStringNode *)node->value;
+    }
+
+    inline const char *string(const LinkNode *node)
+    {
+      return stringNode(node)->u.s ? stringNode(node)->u.s : "";
+    }
+
+    /* Pushes a copy of length bytes at text, plus NUL, as one node */
+    inline LinkNode *pushString(LinkList *list, const char *key, const char *text, size_t length)
+    {
+      char *arena;
+      LLBlockNode *node = key
+        ? keyedBlock(LN_STRING, key, length + 1, &arena)
+        : block(LN_STRING, length + 1, &arena);
+      LLStringNode *data = key ? &node->u.ks.string : &node->u.s;
+
+      std::memcpy(arena, text, length);
+      arena[length] = '\0';
+      data->u.s = arena;
+      data->type = LLSN_STRING;
+      return push(list, node);
+    }
+  }
+
+  #pragma mark - Keys
+
+  /** LLKeyHash evaluated at compile time when key is a constant */
+  constexpr unsigned long keyHash(const char *key, unsigned long hash = 2166136261UL)
+  {
+    return *key
+      ? keyHash(key + 1, ((hash ^ (unsigned long)(unsigned char)(*key >= 'A' && *key <= 'Z' ? *key + ('a' - 'A') : *key))
+        * 16777619UL) & 0xffffffffUL)
+      : hash;
+  }
+
+  /** A key and its hash. Declared constexpr from a literal, as in
+   * constexpr ll::Key name("name"), the hash costs nothing at run time and
+   * KeyedList lookups by it only verify the candidate they land on. */
+  struct Key
+  {
+    const char *name;
+    unsigned long hash;
+
+    template <size_t N> constexpr Key(const char (&literal)[N]) : name(literal), hash(keyHash(literal)) {}
+    constexpr Key(const char *key, unsigned long keyHash) : name(key), hash(keyHash) {}
+  };
+
+  #pragma mark - Type Traits
+
+  /** Maps a C++ value type onto the C library. Only the specializations
+   * below exist, so an unsupported type fails to compile. */
+  template <typename T> struct traits;
+
+  #define LL_HPP_INTEGER(ctype, Name, integerType) \
+    template <> struct traits<ctype> \
+    { \
+      static const int type = LN_INTEGER; \
+      static LinkNode *push(LinkList *list, ctype value) { return LLInlinePush##Name(list, value); } \
+      static bool pop(LinkList *list, ctype &value) { return LLInlinePop##Name(list, &value) != No; } \
+      static bool dequeue(LinkList *list, ctype &value) { return LLInlineDequeue##Name(list, &value) != No; } \
+      static ctype read(const LinkNode *node) { return (ctype)LLIntegerValue(_LLInlineInteger((LinkNode *)node)); } \
+      static LinkNode *pushKeyed(LinkList *list, const char *key, ctype value) \
+      { \
+        char *arena; \
+        LLBlockNode *node = detail::keyedBlock(LN_INTEGER, key, 0, &arena); \
+        LNSetIntByType(&node->u.ki.integer, (LLIntegerType)(integerType), (MAX_INT_TYPE)value); \
+        return detail::push(list, node); \
+      } \
+      static LinkNode *upsert(LinkList *list, const char *key, ctype value) \
+      { \
+        return LLUpsertKeyedInteger(list, (LLKey)key, (MAX_INT_TYPE)value, (LLIntegerType)(integerType)); \
+      } \
+    };
+
+  #define LL_HPP_DECIMAL(ctype, Name, decimalType) \
+    template <> struct traits<ctype> \
+    { \
+      static const int type = LN_DECIMAL; \
+      static LinkNode *push(LinkList *list, ctype value) { return LLInlinePush##Name(list, value); } \
+      static bool pop(LinkList *list, ctype &value) { return LLInlinePop##Name(list, &value) != No; } \
+      static bool dequeue(LinkList *list, ctype &value) { return LLInlineDequeue##Name(list, &value) != No; } \
+      static ctype read(const LinkNode *node) { return (ctype)LLDecimalValue(_LLInlineDecimal((LinkNode *)node)); } \
+      static LinkNode *pushKeyed(LinkList *list, const char *key, ctype value) \
+      { \
+        char *arena; \
+        LLBlockNode *node = detail::keyedBlock(LN_DECIMAL, key, 0, &arena); \
+        LNSetDecByType(&node->u.kd.decimal, (LLDecimalType)(decimalType), (MAX_DEC_TYPE)value); \
+        return detail::push(list, node); \
+      } \
+      static LinkNode *upsert(LinkList *list, const char *key, ctype value) \
+      { \
+        return LLUpsertKeyedDecimal(list, (LLKey)key, (MAX_DEC_TYPE)value, (LLDecimalType)(decimalType)); \
+      } \
+    };
+
+  template <> struct traits<bool>
+  {
+    static const int type = LN_BOOLEAN;
+
+    static LinkNode *push(LinkList *list, bool value) { return LLInlinePushBool(list, value ? Yes : No); }
+
+    static bool pop(LinkList *list, bool &value)
+    {
+      LLBoolean result;
+      if (!LLInlinePopBool(list, &result)) return false;
+      value = result != No;
+      return true;
+    }
+
+    static bool dequeue(LinkList *list, bool &value)
+    {
+      LLBoolean result;
+      if (!LLInlineDequeueBool(list, &result)) return false;
+      value = result != No;
+      return true;
+    }
+
+    static bool read(const LinkNode *node) { return _LLInlineBoolean((LinkNode *)node) != No; }
+
+    static LinkNode *pushKeyed(LinkList *list, const char *key, bool value)
+    {
+      char *arena;
+      LLBlockNode *node = detail::keyedBlock(LN_BOOLEAN, key, 0, &arena);
+      node->u.kb.boolean = value ? Yes : No;
+      return detail::push(list, node);
+    }
+
+    static LinkNode *upsert(LinkList *list, const char *key, bool value)
+    {
+      return LLUpsertKeyedBoolean(list, (LLKey)key, value ? Yes : No);
+    }
+  };
+
+  LL_HPP_INTEGER(char, Char, LLIN_CHAR)
+  LL_HPP_INTEGER(unsigned char, UChar, LLIN_CHAR | LLIN_UNSIGNED)
+  LL_HPP_INTEGER(short, Short, LLIN_SHORT)
+  LL_HPP_INTEGER(unsigned short, UShort, LLIN_SHORT | LLIN_UNSIGNED)
+  LL_HPP_INTEGER(int, Int, LLIN_INT)
+  LL_HPP_INTEGER(unsigned int, UInt, LLIN_INT | LLIN_UNSIGNED)
+  LL_HPP_INTEGER(long, Long, LLIN_LONG)
+  LL_HPP_INTEGER(unsigned long, ULong, LLIN_LONG | LLIN_UNSIGNED)
+  #ifdef BIG_TYPES
+  LL_HPP_INTEGER(long long, LongLong, LLIN_LONG_LONG)
+  LL_HPP_INTEGER(unsigned long long, ULongLong, LLIN_LONG_LONG | LLIN_UNSIGNED)
+  #endif
+
+  LL_HPP_DECIMAL(float, Float, LLDN_FLOAT)
+  LL_HPP_DECIMAL(double, Double, LLDN_DOUBLE)
+  #ifdef BIG_TYPES
+  LL_HPP_DECIMAL(long double, LongDouble, LLDN_LONG_DOUBLE)
+  #endif
+
+  #undef LL_HPP_INTEGER
+  #undef LL_HPP_DECIMAL
+
+  template <> struct traits<std::string>
+  {
+    static const int type = LN_STRING;
+
+    static LinkNode *push(LinkList *list, const std::string &value)
+    {
+      return detail::pushString(list, NULL, value.c_str(), std::strlen(value.c_str()));
+    }
+
+    static bool take(LinkNode *node, std::string &value)
+    {
+      if (!node) return false;
+      value.assign(detail::string(node));
+      _LLInlineFree(node);
+      return true;
+    }
+
+    static bool pop(LinkList *list, std::string &value) { return take(_LLInlinePop(list, LN_STRING), value); }
+    static bool dequeue(LinkList *list, std::string &value) { return take(_LLInlineDequeue(list, LN_STRING), value); }
+    static std::string read(const LinkNode *node) { return std::string(detail::string(node)); }
+
+    static LinkNode *pushKeyed(LinkList *list, const char *key, const std::string &value)
+    {
+      return detail::pushString(list, key, value.c_str(), std::strlen(value.c_str()));
+    }
+
+    static LinkNode *upsert(LinkList *list, const char *key, const std::string &value)
+    {
+      return LLUpsertKeyedString(list, (LLKey)key, (LLVoid)value.c_str(), LLSN_STRING);
+    }
+  };
+
+  /* Pushes copy the text; read hands back a pointer into the node */
+  template <> struct traits<const char *>
+  {
+    static const int type = LN_STRING;
+
+    static LinkNode *push(LinkList *list, const char *value)
+    {
+      return detail::pushString(list, NULL, value ? value : "", value ? std::strlen(value) : 0);
+    }
+
+    static const char *read(const LinkNode *node) { return detail::string(node); }
+
+    static LinkNode *pushKeyed(LinkList *list, const char *key, const char *value)
+    {
+      return detail::pushString(list, key, value ? value : "", value ? std::strlen(value) : 0);
+    }
+
+    static LinkNode *upsert(LinkList *list, const char *key, const char *value)
+    {
+      return LLUpsertKeyedString(list, (LLKey)key, (LLVoid)(value ? value : ""), LLSN_STRING);
+    }
+  };
+
+  /* Other pointers are stored as LN_VOID data and never freed by the list */
+  template <typename P> struct traits<P *>
+  {
+    static const int type = LN_VOID;
+
+    static LinkNode *push(LinkList *list, P *value) { return LLPushVoid(list, (LLVoid)value); }
+
+    static bool take(LinkNode *node, P *&value)
+    {
+      if (!node) return false;
+      value = read(node);
+      LNDelete(node);
+      return true;
+    }
+
+    static bool pop(LinkList *list, P *&value) { return take(_LLInlinePop(list, LN_VOID), value); }
+    static bool dequeue(LinkList *list, P *&value) { return take(_LLInlineDequeue(list, LN_VOID), value); }
+    static P *read(const LinkNode *node) { return (P *)LLNodeData((LinkNode *)node); }
+
+    static LinkNode *pushKeyed(LinkList *list, const char *key, P *value)
+    {
+      return LLPushKeyedVoid(list, (LLKey)key, (LLVoid)value);
+    }
+
+    static LinkNode *upsert(LinkList *list, const char *key, P *value)
+    {
+      return LLUpsertKeyedVoid(list, (LLKey)key, (LLVoid)value);
+    }
+  };
+
+  /** Pushed values are looked up by their decayed type, so literals work
+   * too, and char * is text rather than a void pointer */
+  template <typename T> struct stored { typedef T type; };
+  template <> struct stored<char *> { typedef const char *type; };
+  template <typename T> struct value_traits : traits<typename stored<typename std::decay<T>::type>::type> {};
+
+  #pragma mark - Node Access
+
+  /** Reads node's value as T; node must hold T's data type */
+  template <typename T> inline T value(const LinkNode &node)
+  {
+    return traits<T>::read(&node);
+  }
+
+  /** True when node holds the data type T maps to */
+  template <typename T> inline bool holds(const LinkNode &node)
+  {
+    return node.value && (node.type & LN_TYPE_MASK) == traits<T>::type;
+  }
+
+  /** node's key, or NULL when it is not keyed */
+  inline const char *key(const LinkNode &node)
+  {
+    return node.type & LN_KEYED && node.value ? ((LLKeyedNode *)node.value)->key : NULL;
+  }
+
+  #pragma mark - Iterators
+
+  template <typename Node> class basic_iterator
+  {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef Node value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Node *pointer;
+    typedef Node &reference;
+
+    basic_iterator() : list_(NULL), node_(NULL) {}
+    basic_iterator(LinkList *list, LinkNode *node) : list_(list), node_(node) {}
+
+    /* iterator converts to const_iterator */
+    operator basic_iterator<const LinkNode>() const { return basic_iterator<const LinkNode>(list_, node_); }
+
+    reference operator*() const { return *node_; }
+    pointer operator->() const { return node_; }
+
+    basic_iterator &operator++() { node_ = node_->next; return *this; }
+    basic_iterator operator++(int) { basic_iterator before(*this); ++*this; return before; }
+
+    /* Stepping back from end() lands on the tail */
+    basic_iterator &operator--() { node_ = node_ ? node_->prev : list_->tail; return *this; }
+    basic_iterator operator--(int) { basic_iterator before(*this); --*this; return before; }
+
+    bool operator==(const basic_iterator &other) const { return node_ == other.node_; }
+    bool operator!=(const basic_iterator &other) const { return node_ != other.node_; }
+
+    LinkNode *node() const { return node_; }
+
+  private:
+    LinkList *list_;
+    LinkNode *node_;
+  };
+
+  typedef basic_iterator<LinkNode> iterator;
+  typedef basic_iterator<const LinkNode> const_iterator;
+
+  #pragma mark - List
+
+  class List
+  {
+  public:
+    typedef ll::iterator iterator;
+    typedef ll::const_iterator const_iterator;
+    typedef LinkNode value_type;
+    typedef size_t size_type;
+
+    List() : list_(LLCreate())
+    {
+      if (!list_) throw std::bad_alloc();
+    }
+
+    /** Takes ownership of a list made by LLCreate */
+    explicit List(LinkList *list) : list_(list) {}
+
+    ~List()
+    {
+      if (list_) LLDelete(list_);
+    }
+
+    List(const List &) = delete;
+    List &operator=(const List &) = delete;
+
+    List(List &&other) noexcept : list_(other.list_)
+    {
+      other.list_ = NULL;
+    }
+
+    List &operator=(List &&other) noexcept
+    {
+      if (this != &other)
+      {
+        if (list_) LLDelete(list_);
+        list_ = other.list_;
+        other.list_ = NULL;
+      }
+      return *this;
+    }
+
+    LinkList *get() const { return list_; }
+
+    /** Gives up ownership; the caller must LLDelete the result */
+    LinkList *release()
+    {
+      LinkList *list = list_;
+      list_ = NULL;
+      return list;
+    }
+
+    size_type size() const { return LLLength(list_); }
+    bool empty() const { return !list_ || !list_->head; }
+
+    template <typename T> LinkNode *push(T &&value)
+    {
+      return value_traits<T>::push(list_, std::forward<T>(value));
+    }
+
+    /** Builds a T from args and pushes it */
+    template <typename T, typename... Args> LinkNode *emplace(Args &&... args)
+    {
+      return traits<T>::push(list_, T(std::forward<Args>(args)...));
+    }
+
+    /* Each stores the value taken from the tail (pop) or head (dequeue) and
+     * frees its node; false when empty or the node holds another type */
+    template <typename T> bool pop(T &value) { return traits<T>::pop(list_, value); }
+    template <typename T> bool dequeue(T &value) { return traits<T>::dequeue(list_, value); }
+
+    /** Unlinks and deletes the node at position */
+    iterator erase(iterator position)
+    {
+      LinkNode *node = position.node(), *next = node->next;
+
+      LLRemoveNode(list_, node);
+      LNDelete(node);
+      return iterator(list_, next);
+    }
+
+    void clear()
+    {
+      LinkNode *node;
+      while ((node = LLPopNode(list_)) != NULL) LNDelete(node);
+    }
+
+    /** Moves every node of other onto the end of this list */
+    void append(List &&other)
+    {
+      if (other.list_) LLConcat(list_, other.list_);
+    }
+
+    iterator begin() { return iterator(list_, list_ ? list_->head : NULL); }
+    iterator end() { return iterator(list_, NULL); }
+    const_iterator begin() const { return const_iterator(list_, list_ ? list_->head : NULL); }
+    const_iterator end() const { return const_iterator(list_, NULL); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+  protected:
+    LinkList *list_;
+  };
+
+  #pragma mark - Keyed List
+
+  /** A list of keyed T values. With unique keys, the default, each push
+   * replaces any node already holding its key; otherwise keys may repeat
+   * and lookups find the earliest pushed. Either way the key index is on. */
+  template <typename T> class KeyedList : public List
+  {
+  public:
+    explicit KeyedList(bool uniqueKeys = true)
+    {
+      if (uniqueKeys) LLEnableUniqueKeys(list_, Yes);
+      else LLEnableKeyIndex(list_, Yes);
+    }
+
+    KeyedList(KeyedList &&other) noexcept : List(std::move(other)) {}
+
+    KeyedList &operator=(KeyedList &&other) noexcept
+    {
+      List::operator=(std::move(other));
+      return *this;
+    }
+
+    LinkNode *push(const char *key, const T &value) { return traits<T>::pushKeyed(list_, key, value); }
+    LinkNode *push(const std::string &key, const T &value) { return push(key.c_str(), value); }
+
+    /** Sets the value of key in place where its node allows */
+    LinkNode *upsert(const char *key, const T &value) { return traits<T>::upsert(list_, key, value); }
+    LinkNode *upsert(const std::string &key, const T &value) { return upsert(key.c_str(), value); }
+
+    /* Lookups take a key string, hashed per call, or a precomputed Key */
+    LinkNode *find(const char *key) const { return holding(LLFindKeyed(list_, (LLKey)key)); }
+    LinkNode *find(const Key &key) const { return holding(LLFindKeyedHashed(list_, (LLKey)key.name, key.hash)); }
+
+    bool contains(const char *key) const { return find(key) != NULL; }
+    bool contains(const Key &key) const { return find(key) != NULL; }
+
+    /** Copies key's value into value; false when key is absent */
+    bool get(const char *key, T &value) const { return read(find(key), value); }
+    bool get(const Key &key, T &value) const { return read(find(key), value); }
+
+    /** Deletes the node found for key; false when key is absent */
+    bool erase(const char *key) { return remove(find(key)); }
+    bool erase(const Key &key) { return remove(find(key)); }
+
+    using List::erase;
+    using List::get;
+
+  private:
+    static LinkNode *holding(LinkNode *node) { return node && holds<T>(*node) ? node : NULL; }
+
+    static bool read(LinkNode *node, T &value)
+    {
+      if (!node) return false;
+      value = traits<T>::read(node);
+      return true;
+    }
+
+    bool remove(LinkNode *node)
+    {
+      if (!node) return false;
+      LLRemoveNode(list_, node);
+      LNDelete(node);
+      return true;
+    }
+  };
+}
+
+#endif
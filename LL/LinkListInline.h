@@ -0,0 +1,231 @@
+#ifndef LINK_LIST_INLINE_H
+#define LINK_LIST_INLINE_H
+
+#include <stdlib.h>
+
+#include "LinkList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Opt-in, type specialized push, pop and dequeue for the scalar types,
+ * compiled into the caller. Each function is named for its C type, as in
+ * LLInlinePushInt, LLInlinePopInt and LLInlineDequeueInt, and so skips the
+ * method table, the LLIntegerType switch and the calls in between.
+ *
+ * Nodes are single allocation LN_BLOCK nodes, laid out exactly as those of
+ * LLNodeBlockCreate(1, 0, NULL), so the rest of the library and LNDelete
+ * treat them like any other. Lists with an index, key filter, aggregates
+ * or trace hooks active take the library path for every node, so their
+ * bookkeeping stays exact; builds with LL_STATS or LL_USDT always do.
+ *
+ * Pops and dequeues hand back the value and free the node. They return No
+ * and leave the list alone when it is empty or the node at that end holds
+ * another data type. Values stored at another width, say by LLPushInteger
+ * with LLIN_LONG, are converted as LLIntegerValue would. */
+
+#if defined(__cplusplus) || (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+#define LL_INLINE static inline
+#elif defined(__GNUC__)
+#define LL_INLINE static __inline__
+#else
+#define LL_INLINE static
+#endif
+
+#pragma mark - Internal Helpers
+
+#if defined(LL_STATS) || defined(LL_USDT)
+#define _LLInlinePlain(list) No
+#else
+extern LLTraceFn _LLTraceBegin;
+#define _LLInlinePlain(list) \
+  (!(list)->dataIndex && !(list)->keyIndex && !(list)->intKeyIndex && !(list)->keyFilter \
+    && !(list)->aggregates && !_LLTraceBegin)
+#endif
+
+LL_INLINE LLBlockNode *_LLInlineNode(int type)
+{
+  LLNodeBlock *block = (LLNodeBlock *)malloc(sizeof(LLNodeBlock) + sizeof(LLBlockNode));
+  LLBlockNode *node;
+
+  if (!block) return NULL;
+
+  block->live = 1;
+  node = (LLBlockNode *)(block + 1);
+  node->link.next = NULL;
+  node->link.prev = NULL;
+  node->link.value = &node->u;
+  node->link.type = (LinkNodeDataType)(type | LN_BLOCK);
+  node->block = block;
+  return node;
+}
+
+LL_INLINE LinkNode *_LLInlineAttach(LinkList *list, LLBlockNode *node)
+{
+  if (!node) return NULL;
+  if (!_LLInlinePlain(list)) return LLPush(list, &node->link);
+
+  node->link.prev = list->tail;
+  if (list->tail) list->tail->next = &node->link;
+  else list->head = &node->link;
+  list->tail = &node->link;
+  list->length++;
+  return &node->link;
+}
+
+LL_INLINE LinkNode *_LLInlinePop(LinkList *list, int type)
+{
+  LinkNode *node = list->tail;
+
+  if (!node || !node->value || (int)(node->type & LN_TYPE_MASK) != type) return NULL;
+  if (!_LLInlinePlain(list)) return LLPopNode(list);
+
+  list->tail = node->prev;
+  if (list->tail) list->tail->next = NULL;
+  else list->head = NULL;
+  node->prev = NULL;
+  list->length--;
+  return node;
+}
+
+LL_INLINE LinkNode *_LLInlineDequeue(LinkList *list, int type)
+{
+  LinkNode *node = list->head;
+
+  if (!node || !node->value || (int)(node->type & LN_TYPE_MASK) != type) return NULL;
+  if (!_LLInlinePlain(list)) return LLDequeueNode(list);
+
+  list->head = node->next;
+  if (list->head) list->head->prev = NULL;
+  else list->tail = NULL;
+  node->next = NULL;
+  list->length--;
+  return node;
+}
+
+LL_INLINE void _LLInlineFree(LinkNode *node)
+{
+  if (!(node->type & LN_BLOCK)) LNDelete(node);
+  else if (--((LLBlockNode *)node)->block->live == 0) free(((LLBlockNode *)node)->block);
+}
+
+LL_INLINE LLBoolean _LLInlineBoolean(LinkNode *node)
+{
+  return node->type & LN_KEYED ? ((LLKeyedBool *)node->value)->boolean : ((LLBoolNode *)node->value)->boolean;
+}
+
+LL_INLINE LLIntegerNode *_LLInlineInteger(LinkNode *node)
+{
+  return node->type & LN_KEYED ? &((LLKeyedInteger *)node->value)->integer : (LLIntegerNode *)node->value;
+}
+
+LL_INLINE LLDecimalNode *_LLInlineDecimal(LinkNode *node)
+{
+  return node->type & LN_KEYED ? &((LLKeyedDecimal *)node->value)->decimal : (LLDecimalNode *)node->value;
+}
+
+#pragma mark - Generators
+
+/* Each expands to the push, pop and dequeue of one C type */
+#define LL_INLINE_INTEGER(Name, ctype, member, integerType) \
+  LL_INLINE LinkNode *LLInlinePush##Name(LinkList *list, ctype value) \
+  { \
+    LLBlockNode *node = _LLInlineNode(LN_INTEGER); \
+    if (node) { node->u.i.u.member = value; node->u.i.type = (LLIntegerType)(integerType); } \
+    return _LLInlineAttach(list, node); \
+  } \
+  LL_INLINE LLBoolean _LLInlineTake##Name(LinkNode *node, ctype *value) \
+  { \
+    LLIntegerNode *data; \
+    if (!node) return No; \
+    data = _LLInlineInteger(node); \
+    *value = data->type == (integerType) ? data->u.member : (ctype)LLIntegerValue(data); \
+    _LLInlineFree(node); \
+    return Yes; \
+  } \
+  LL_INLINE LLBoolean LLInlinePop##Name(LinkList *list, ctype *value) \
+  { \
+    return _LLInlineTake##Name(_LLInlinePop(list, LN_INTEGER), value); \
+  } \
+  LL_INLINE LLBoolean LLInlineDequeue##Name(LinkList *list, ctype *value) \
+  { \
+    return _LLInlineTake##Name(_LLInlineDequeue(list, LN_INTEGER), value); \
+  }
+
+#define LL_INLINE_DECIMAL(Name, ctype, member, decimalType) \
+  LL_INLINE LinkNode *LLInlinePush##Name(LinkList *list, ctype value) \
+  { \
+    LLBlockNode *node = _LLInlineNode(LN_DECIMAL); \
+    if (node) { node->u.d.u.member = value; node->u.d.type = (LLDecimalType)(decimalType); } \
+    return _LLInlineAttach(list, node); \
+  } \
+  LL_INLINE LLBoolean _LLInlineTake##Name(LinkNode *node, ctype *value) \
+  { \
+    LLDecimalNode *data; \
+    if (!node) return No; \
+    data = _LLInlineDecimal(node); \
+    *value = data->type == (decimalType) ? data->u.member : (ctype)LLDecimalValue(data); \
+    _LLInlineFree(node); \
+    return Yes; \
+  } \
+  LL_INLINE LLBoolean LLInlinePop##Name(LinkList *list, ctype *value) \
+  { \
+    return _LLInlineTake##Name(_LLInlinePop(list, LN_DECIMAL), value); \
+  } \
+  LL_INLINE LLBoolean LLInlineDequeue##Name(LinkList *list, ctype *value) \
+  { \
+    return _LLInlineTake##Name(_LLInlineDequeue(list, LN_DECIMAL), value); \
+  }
+
+#pragma mark - Inline Functions
+
+LL_INLINE LinkNode *LLInlinePushBool(LinkList *list, LLBoolean value)
+{
+  LLBlockNode *node = _LLInlineNode(LN_BOOLEAN);
+  if (node) node->u.b.boolean = value;
+  return _LLInlineAttach(list, node);
+}
+
+LL_INLINE LLBoolean _LLInlineTakeBool(LinkNode *node, LLBoolean *value)
+{
+  if (!node) return No;
+  *value = _LLInlineBoolean(node);
+  _LLInlineFree(node);
+  return Yes;
+}
+
+LL_INLINE LLBoolean LLInlinePopBool(LinkList *list, LLBoolean *value)
+{
+  return _LLInlineTakeBool(_LLInlinePop(list, LN_BOOLEAN), value);
+}
+
+LL_INLINE LLBoolean LLInlineDequeueBool(LinkList *list, LLBoolean *value)
+{
+  return _LLInlineTakeBool(_LLInlineDequeue(list, LN_BOOLEAN), value);
+}
+
+LL_INLINE_INTEGER(Char, char, c, LLIN_CHAR)
+LL_INLINE_INTEGER(UChar, unsigned char, uc, LLIN_CHAR | LLIN_UNSIGNED)
+LL_INLINE_INTEGER(Short, short, s, LLIN_SHORT)
+LL_INLINE_INTEGER(UShort, unsigned short, us, LLIN_SHORT | LLIN_UNSIGNED)
+LL_INLINE_INTEGER(Int, int, i, LLIN_INT)
+LL_INLINE_INTEGER(UInt, unsigned int, ui, LLIN_INT | LLIN_UNSIGNED)
+LL_INLINE_INTEGER(Long, long, l, LLIN_LONG)
+LL_INLINE_INTEGER(ULong, unsigned long, ul, LLIN_LONG | LLIN_UNSIGNED)
+#ifdef BIG_TYPES
+LL_INLINE_INTEGER(LongLong, long long, ll, LLIN_LONG_LONG)
+LL_INLINE_INTEGER(ULongLong, unsigned long long, ull, LLIN_LONG_LONG | LLIN_UNSIGNED)
+#endif
+
+LL_INLINE_DECIMAL(Float, float, f, LLDN_FLOAT)
+LL_INLINE_DECIMAL(Double, double, d, LLDN_DOUBLE)
+#ifdef BIG_TYPES
+LL_INLINE_DECIMAL(LongDouble, long double, ld, LLDN_LONG_DOUBLE)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,109 @@
+/* Replays a Zipfian key trace against LLCache and reports hit rate and
+ * throughput for a range of cache capacities.
+ *
+ *   ll_bench_cache [keys] [requests] [skew]
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "LLCache.h"
+
+unsigned long benchRandom(unsigned long *state)
+{
+  /* xorshift keeps the trace identical across platforms and runs */
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+double *zipfTable(size_t keys, double skew)
+{
+  double *cdf = (double *)malloc(keys * sizeof(double));
+  double total = 0.0;
+  size_t i;
+
+  for (i = 0; i < keys; i++) total += 1.0 / pow((double)(i + 1), skew);
+  for (i = 0; i < keys; i++)
+  {
+    cdf[i] = (i ? cdf[i - 1] : 0.0) + (1.0 / pow((double)(i + 1), skew)) / total;
+  }
+  return cdf;
+}
+
+size_t zipfSample(double *cdf, size_t keys, unsigned long *state)
+{
+  double u = (double)(benchRandom(state) % 1000000007UL) / 1000000007.0;
+  size_t low = 0, high = keys - 1, mid;
+
+  while (low < high)
+  {
+    mid = (low + high) / 2;
+    if (cdf[mid] < u) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+void evicted(LinkNode *node, LLVoid context)
+{
+  (void)node;
+  (*(unsigned long *)context)++;
+}
+
+int main(int argc, char **argv)
+{
+  size_t keys = argc > 1 ? (size_t)atol(argv[1]) : 1000000;
+  size_t requests = argc > 2 ? (size_t)atol(argv[2]) : 5000000;
+  double skew = argc > 3 ? atof(argv[3]) : 0.99;
+  size_t capacities[] = { 1000, 10000, 100000, 1000000 };
+  size_t *trace = (size_t *)malloc(requests * sizeof(size_t));
+  double *cdf = zipfTable(keys, skew);
+  unsigned long state = 88172645463325252UL, callbacks;
+  char key[32];
+  LLCacheStats stats;
+  LLCache *cache;
+  clock_t start;
+  double seconds;
+  size_t c, i;
+
+  for (i = 0; i < requests; i++) trace[i] = zipfSample(cdf, keys, &state);
+
+  printf("[\n");
+  for (c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++)
+  {
+    callbacks = 0;
+    cache = LLCacheCreate(capacities[c], evicted, &callbacks);
+
+    start = clock();
+    for (i = 0; i < requests; i++)
+    {
+      sprintf(key, "key:%lu", (unsigned long)trace[i]);
+      if (!LLCacheGet(cache, key))
+      {
+        LLCachePutInteger(cache, key, (MAX_INT_TYPE)trace[i], LLIN_LONG);
+      }
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    LLCacheGetStats(cache, &stats);
+    printf(
+      "  {\"capacity\": %lu, \"keys\": %lu, \"requests\": %lu, \"skew\": %.2f, "
+      "\"hit_rate\": %.4f, \"evictions\": %lu, \"ns_per_op\": %.1f}%s\n",
+      (unsigned long)capacities[c], (unsigned long)keys, (unsigned long)requests,
+      skew, (double)stats.hits / (double)requests, stats.evictions,
+      seconds * 1e9 / (double)requests,
+      c + 1 < sizeof(capacities) / sizeof(capacities[0]) ? "," : ""
+    );
+
+    if (callbacks != stats.evictions) fprintf(stderr, "eviction callback mismatch\n");
+    LLCacheDelete(cache);
+  }
+  printf("]\n");
+
+  free(trace);
+  free(cdf);
+  return 0;
+}
@@ -0,0 +1,119 @@
+/* Times pushes through LinkList.hpp against the C calls a hand written
+ * wrapper makes, for ints, std::strings and keyed ints, and prints one
+ * JSON record per case with nanoseconds per push and per full drain.
+ *
+ *   ll_bench_cpp [count]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "LinkList.hpp"
+
+typedef std::chrono::steady_clock BenchClock;
+
+static double benchNs(BenchClock::time_point start, size_t count)
+{
+  return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / (double)count;
+}
+
+static void benchReport(const char *name, double pushNs, double drainNs, const char *separator)
+{
+  std::printf("%s\n  { \"name\": \"%s\", \"pushNs\": %.1f, \"drainNs\": %.1f }", separator, name, pushNs, drainNs);
+}
+
+/* The C side drains as LLDequeueNode plus LNDelete */
+static double benchDrainC(LinkList *list, size_t count)
+{
+  BenchClock::time_point start = BenchClock::now();
+  LinkNode *node;
+
+  while ((node = LLDequeueNode(list)) != NULL) LNDelete(node);
+  return benchNs(start, count);
+}
+
+int main(int argc, char **argv)
+{
+  size_t count = argc > 1 ? (size_t)std::atol(argv[1]) : 1000000, i;
+  std::vector<std::string> strings, keys;
+  BenchClock::time_point start;
+  double pushNs, drainNs;
+  LinkList *list;
+  char *copy;
+  int value;
+
+  for (i = 0; i < count; i++)
+  {
+    strings.push_back("sensor-reading-" + std::to_string(i));
+    keys.push_back("key-" + std::to_string(i));
+  }
+
+  std::printf("{ \"count\": %lu, \"benchmarks\": [", (unsigned long)count);
+
+  list = LLCreate();
+  start = BenchClock::now();
+  for (i = 0; i < count; i++) list->pushInt(list, (int)i);
+  pushNs = benchNs(start, count);
+  benchReport("int_method", pushNs, benchDrainC(list, count), "");
+  LLDelete(list);
+
+  {
+    ll::List wrapped;
+    start = BenchClock::now();
+    for (i = 0; i < count; i++) wrapped.push((int)i);
+    pushNs = benchNs(start, count);
+    start = BenchClock::now();
+    while (wrapped.dequeue(value));
+    benchReport("int_wrapper", pushNs, benchNs(start, count), ",");
+  }
+
+  /* What hand wrappers did: copy out of the std::string, then push a copy */
+  list = LLCreate();
+  start = BenchClock::now();
+  for (i = 0; i < count; i++)
+  {
+    copy = strdup(strings[i].c_str());
+    LLPushString(list, copy, LLSN_STRING);
+    free(copy);
+  }
+  pushNs = benchNs(start, count);
+  benchReport("string_hand_wrapped", pushNs, benchDrainC(list, count), ",");
+  LLDelete(list);
+
+  {
+    std::vector<std::string> moved(strings);
+    std::string out;
+    ll::List wrapped;
+
+    start = BenchClock::now();
+    for (i = 0; i < count; i++) wrapped.push(std::move(moved[i]));
+    pushNs = benchNs(start, count);
+    start = BenchClock::now();
+    while (wrapped.dequeue(out));
+    benchReport("string_wrapper", pushNs, benchNs(start, count), ",");
+  }
+
+  list = LLCreate();
+  start = BenchClock::now();
+  for (i = 0; i < count; i++) LLPushKeyedInteger(list, (LLKey)keys[i].c_str(), (MAX_INT_TYPE)i, LLIN_INT);
+  pushNs = benchNs(start, count);
+  drainNs = benchDrainC(list, count);
+  benchReport("keyed_int_c", pushNs, drainNs, ",");
+  LLDelete(list);
+
+  {
+    ll::KeyedList<int> wrapped(false);
+    LLEnableKeyIndex(wrapped.get(), No);
+
+    start = BenchClock::now();
+    for (i = 0; i < count; i++) wrapped.push(keys[i].c_str(), (int)i);
+    pushNs = benchNs(start, count);
+    benchReport("keyed_int_wrapper", pushNs, benchDrainC(wrapped.get(), count), ",");
+  }
+
+  std::printf("\n] }\n");
+  return 0;
+}
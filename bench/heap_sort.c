@@ -0,0 +1,114 @@
+/* Compares LLHeap against re-sorting a LinkList after every push for a
+ * "pop smallest deadline" workload. The queue is first filled with n
+ * deadlines, then each operation pops the minimum and pushes a new one.
+ *
+ *   ll_bench_heap [operations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "LLHeap.h"
+
+unsigned long benchRandom(unsigned long *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+int compareNodes(const void *a, const void *b)
+{
+  return LLHeapCompareInteger(*(LinkNode **)a, *(LinkNode **)b);
+}
+
+/* What callers did before: rebuild the list in order after each push */
+void sortList(LinkList *list, LinkNode **scratch)
+{
+  LinkNode *node;
+  size_t count = 0, i;
+
+  for (node = list->head; node; node = node->next) scratch[count++] = node;
+  qsort(scratch, count, sizeof(LinkNode *), compareNodes);
+
+  list->head = count ? scratch[0] : NULL;
+  list->tail = count ? scratch[count - 1] : NULL;
+  for (i = 0; i < count; i++)
+  {
+    scratch[i]->prev = i ? scratch[i - 1] : NULL;
+    scratch[i]->next = i + 1 < count ? scratch[i + 1] : NULL;
+  }
+}
+
+double benchSortedList(size_t size, size_t operations)
+{
+  LinkNode **scratch = (LinkNode **)malloc((size + 1) * sizeof(LinkNode *));
+  unsigned long state = 2463534242UL;
+  LinkList *list = LLCreate();
+  LinkNode *node;
+  clock_t start;
+  size_t i;
+
+  for (i = 0; i < size; i++) LLPushInteger(list, (long)(benchRandom(&state) % 1000000000UL), LLIN_LONG);
+  sortList(list, scratch);
+
+  start = clock();
+  for (i = 0; i < operations; i++)
+  {
+    node = LLDequeueNode(list);
+    LLPushInteger(list, LLIntegerValue((LLIntegerNode *)node->value) + (long)(benchRandom(&state) % 1000UL), LLIN_LONG);
+    LNDelete(node);
+    sortList(list, scratch);
+  }
+
+  free(scratch);
+  LLDelete(list);
+  return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (double)operations;
+}
+
+double benchHeap(size_t size, size_t operations)
+{
+  unsigned long state = 2463534242UL;
+  LLHeap *heap = LLHeapCreate(LLHeapCompareInteger);
+  LLHeapNode *node;
+  clock_t start;
+  size_t i;
+
+  for (i = 0; i < size; i++) LLHeapPushInteger(heap, (long)(benchRandom(&state) % 1000000000UL), LLIN_LONG);
+
+  start = clock();
+  for (i = 0; i < operations; i++)
+  {
+    node = LLHeapPop(heap);
+    LLHeapPushInteger(heap, LLIntegerValue((LLIntegerNode *)node->link.value) + (long)(benchRandom(&state) % 1000UL), LLIN_LONG);
+    LNDelete(&node->link);
+  }
+
+  LLHeapDelete(heap);
+  return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (double)operations;
+}
+
+int main(int argc, char **argv)
+{
+  size_t operations = argc > 1 ? (size_t)atol(argv[1]) : 100000;
+  size_t sizes[] = { 10000, 100000, 1000000 };
+  size_t i, sortOperations;
+
+  printf("[\n");
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    /* Re-sorting is O(n log n) per operation; sample fewer to stay bounded */
+    sortOperations = 2000000 / sizes[i];
+    if (sortOperations < 5) sortOperations = 5;
+
+    printf(
+      "  {\"size\": %lu, \"heap_ns_per_op\": %.1f, \"resort_ns_per_op\": %.1f}%s\n",
+      (unsigned long)sizes[i], benchHeap(sizes[i], operations),
+      benchSortedList(sizes[i], sortOperations),
+      i + 1 < sizeof(sizes) / sizeof(sizes[0]) ? "," : ""
+    );
+  }
+  printf("]\n");
+  return 0;
+}
@@ -0,0 +1,78 @@
+/* Compares an LLIntSeq against a LinkList of LLIN_LONG nodes holding the
+ * same telemetry style timestamps: monotonic, a few milliseconds apart
+ * with jitter. Reports bytes per element, sequential decode throughput
+ * and random access cost.
+ *
+ *   ll_bench_intseq [count]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "LLIntSeq.h"
+
+/* Rough malloc cost of one block: the request rounded up plus a header */
+#define BENCH_MALLOC(size) ((((size) + 8 + 15) / 16) * 16)
+
+unsigned long benchRandom(unsigned long *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+double benchSeconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+  size_t count = argc > 1 ? (size_t)atol(argv[1]) : 4000000;
+  unsigned long state = 88172645463325252UL;
+  MAX_INT_TYPE *out = (MAX_INT_TYPE *)malloc(4096 * sizeof(MAX_INT_TYPE));
+  MAX_INT_TYPE value = 1700000000000L, sum = 0;
+  LinkList *list = LLCreate();
+  LLIntSeq *seq;
+  LinkNode *node;
+  size_t i, j, decoded, lookups = 1000000;
+  double listBytes, listSeconds, seqSeconds, randomSeconds;
+  clock_t start;
+
+  for (i = 0; i < count; i++)
+  {
+    value += 1 + (MAX_INT_TYPE)(benchRandom(&state) % 20);
+    LLPushInteger(list, value, LLIN_LONG);
+  }
+
+  seq = LLIntSeqFromList(list, LLIN_LONG);
+  listBytes = (double)(BENCH_MALLOC(sizeof(LinkNode)) + BENCH_MALLOC(sizeof(LLIntegerNode)));
+
+  start = clock();
+  for (node = list->head; node; node = node->next) sum += LLIntegerValue((LLIntegerNode *)node->value);
+  listSeconds = benchSeconds(start);
+
+  start = clock();
+  for (i = 0; i < count; i += decoded)
+  {
+    decoded = LLIntSeqDecode(seq, i, out, 4096);
+    for (j = 0; j < decoded; j++) sum -= out[j];
+  }
+  seqSeconds = benchSeconds(start);
+
+  start = clock();
+  for (i = 0; i < lookups; i++) sum += LLIntSeqAt(seq, benchRandom(&state) % count);
+  randomSeconds = benchSeconds(start);
+
+  printf("{ \"count\": %lu, \"list\": { \"bytesPerElement\": %.1f, \"decodeMPerSecond\": %.1f },\n",
+    (unsigned long)count, listBytes, count / listSeconds / 1e6);
+  printf("  \"intseq\": { \"bytesPerElement\": %.2f, \"decodeMPerSecond\": %.1f, \"randomAccessNs\": %.1f },\n",
+    (double)LLIntSeqFootprint(seq) / count, count / seqSeconds / 1e6, randomSeconds / lookups * 1e9);
+  printf("  \"checksum\": %ld }\n", (long)sum);
+
+  LLIntSeqDelete(seq);
+  LLDelete(list);
+  free(out);
+  return 0;
+}
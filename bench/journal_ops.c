@@ -0,0 +1,88 @@
+/* Measures durable operations per second through LLJournal at several
+ * group commit batch sizes. Each operation is a work queue step: push an
+ * integer and, once the queue holds 1024 items, dequeue the oldest. Every
+ * run ends with a sync so all of its operations are on disk.
+ *
+ *   ll_bench_journal [directory] [operations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "LLJournal.h"
+
+double benchSeconds(void)
+{
+  struct timeval now;
+
+  gettimeofday(&now, NULL);
+  return now.tv_sec + now.tv_usec / 1e6;
+}
+
+void benchRemove(const char *path)
+{
+  const char *suffixes[] = { ".snap", ".log", ".old" };
+  char name[1024];
+  int i;
+
+  for (i = 0; i < 3; i++)
+  {
+    sprintf(name, "%s%s", path, suffixes[i]);
+    remove(name);
+  }
+}
+
+double benchJournal(const char *path, size_t batchSize, size_t operations)
+{
+  LLJournal *journal;
+  LinkNode *node;
+  double start, elapsed;
+  size_t i;
+
+  benchRemove(path);
+  journal = LLJournalOpen(path, batchSize, 0);
+  if (!journal) return 0;
+
+  start = benchSeconds();
+  for (i = 0; i < operations; i++)
+  {
+    LLJournalPushInteger(journal, (long)i, LLIN_LONG);
+    if (i >= 1024 && (node = LLJournalDequeue(journal)) != NULL) LNDelete(node);
+  }
+  LLJournalSync(journal);
+  elapsed = benchSeconds() - start;
+
+  LLJournalClose(journal);
+  benchRemove(path);
+  return elapsed;
+}
+
+int main(int argc, char **argv)
+{
+  size_t batches[] = { 1, 8, 64, 512, 4096 };
+  const char *directory = argc > 1 ? argv[1] : ".";
+  size_t operations = argc > 2 ? (size_t)atol(argv[2]) : 20000;
+  char path[1000];
+  double seconds;
+  size_t i, scaled;
+
+  if (strlen(directory) > 900) return 1;
+  sprintf(path, "%s/ll_bench_journal", directory);
+
+  printf("[\n");
+  for (i = 0; i < sizeof(batches) / sizeof(batches[0]); i++)
+  {
+    /* fsync bound runs get fewer operations to keep the total time sane */
+    scaled = batches[i] < 64 ? operations / (64 / batches[i]) : operations;
+    if (scaled < 100) scaled = 100;
+
+    seconds = benchJournal(path, batches[i], scaled);
+    printf("  { \"batch\": %lu, \"operations\": %lu, \"seconds\": %.3f, \"opsPerSecond\": %.0f }%s\n",
+      (unsigned long)batches[i], (unsigned long)scaled, seconds,
+      seconds > 0 ? scaled / seconds : 0.0, i + 1 < sizeof(batches) / sizeof(batches[0]) ? "," : "");
+  }
+  printf("]\n");
+
+  return 0;
+}
@@ -0,0 +1,666 @@
+/* The regression suite for the core list. Every case runs at each size
+ * from 10 up to the maximum in powers of ten, repeated until at least a
+ * million operations are timed, and reports one JSON record:
+ *
+ *   { "name", "size", "ops", "nsPerOp", "allocsPerOp", "peakRssKb" }
+ *
+ * On POSIX systems each case runs in its own child process so peakRssKb
+ * belongs to that case alone. Allocations are counted where the linker
+ * can wrap malloc (see CMakeLists.txt); elsewhere allocsPerOp is null.
+ *
+ *   ll_bench [maxSize] [name filter]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCH_FORK 1
+#endif
+
+#include "LinkList.h"
+#include "LinkListInline.h"
+#include "LLTypedList.h"
+
+#define BENCH_MIN_OPS 1000000
+
+/* Cases whose operations scan the whole list are capped per repetition */
+#define BENCH_SCAN_OPS 1000
+
+#pragma mark - Allocation Counting
+
+unsigned long benchAllocs = 0;
+
+#ifdef LL_BENCH_WRAP
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+  benchAllocs++;
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+  benchAllocs++;
+  return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size)
+{
+  benchAllocs++;
+  return __real_realloc(pointer, size);
+}
+#endif
+
+#pragma mark - Timing
+
+typedef struct BenchResult
+{
+  double seconds;
+  double ops;
+  unsigned long allocs;
+  long peakRssKb;
+
+  /* Open measurement */
+  double start;
+  unsigned long startAllocs;
+} BenchResult;
+
+typedef void (*BenchFn)(size_t size, int type, BenchResult *result);
+
+typedef struct BenchCase
+{
+  const char *name;
+  BenchFn run;
+  int type;
+} BenchCase;
+
+/* Small sizes time regions of a microsecond or less, so prefer ns ticks */
+double benchSeconds(void)
+{
+  #ifdef BENCH_FORK
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec / 1e9;
+  #else
+  struct timeval now;
+
+  gettimeofday(&now, NULL);
+  return now.tv_sec + now.tv_usec / 1e6;
+  #endif
+}
+
+void benchStart(BenchResult *result)
+{
+  result->startAllocs = benchAllocs;
+  result->start = benchSeconds();
+}
+
+void benchStop(BenchResult *result, size_t ops)
+{
+  result->seconds += benchSeconds() - result->start;
+  result->allocs += benchAllocs - result->startAllocs;
+  result->ops += (double)ops;
+}
+
+unsigned long benchRandom(unsigned long *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+/* Keys are formatted by hand so building one costs next to nothing */
+char *benchKey(char *buffer, size_t value)
+{
+  static const char digits[] = "0123456789abcdef";
+  char *cursor = buffer;
+
+  *cursor++ = 'k';
+  do
+  {
+    *cursor++ = digits[value & 15];
+    value >>= 4;
+  } while (value);
+  *cursor = '\0';
+  return buffer;
+}
+
+/* Void nodes carry fake, distinct and never dereferenced pointers */
+LLVoid benchPointer(size_t value)
+{
+  return (LLVoid)((value + 1) * 16);
+}
+
+LinkNode *benchPush(LinkList *list, int type, size_t value)
+{
+  switch (type)
+  {
+    case LN_BOOLEAN: return LLPushBoolean(list, value & 1 ? Yes : No);
+    case LN_DECIMAL: return LLPushDecimal(list, (MAX_DEC_TYPE)value * 0.5, LLDN_DOUBLE);
+    case LN_STRING: return LLPushString(list, "benchmark", LLSN_STRING);
+    case LN_VOID: return LLPushVoid(list, benchPointer(value));
+    default: return LLPushInteger(list, (MAX_INT_TYPE)value, LLIN_LONG);
+  }
+}
+
+LinkList *benchFill(size_t size, int type)
+{
+  LinkList *list = LLCreate();
+  size_t i;
+
+  for (i = 0; i < size; i++) benchPush(list, type, i);
+  return list;
+}
+
+LinkList *benchFillKeyed(size_t size)
+{
+  LinkList *list = LLCreate();
+  char key[32];
+  size_t i;
+
+  for (i = 0; i < size; i++) LLPushKeyedInteger(list, benchKey(key, i), (MAX_INT_TYPE)i, LLIN_LONG);
+  return list;
+}
+
+#pragma mark - Cases
+
+void benchPushType(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = LLCreate();
+  size_t i;
+
+  benchStart(result);
+  for (i = 0; i < size; i++) benchPush(list, type, i);
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+void benchPopType(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFill(size, type);
+  LinkNode *node;
+
+  benchStart(result);
+  while ((node = LLPopNode(list)) != NULL) LNDelete(node);
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+void benchDequeueType(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFill(size, type);
+  LinkNode *node;
+
+  benchStart(result);
+  while ((node = LLDequeueNode(list)) != NULL) LNDelete(node);
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+/* type selects the path: the method table, or LinkListInline.h */
+void benchPushInt(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = LLCreate();
+  size_t i;
+
+  benchStart(result);
+  if (type) for (i = 0; i < size; i++) LLInlinePushInt(list, (int)i);
+  else for (i = 0; i < size; i++) list->pushInt(list, (int)i);
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+LinkList *benchFillInline(size_t size)
+{
+  LinkList *list = LLCreate();
+  size_t i;
+
+  for (i = 0; i < size; i++) LLInlinePushInt(list, (int)i);
+  return list;
+}
+
+void benchPopIntInline(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFillInline(size);
+  int value;
+
+  (void)type;
+  benchStart(result);
+  while (LLInlinePopInt(list, &value));
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+void benchDequeueIntInline(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFillInline(size);
+  int value;
+
+  (void)type;
+  benchStart(result);
+  while (LLInlineDequeueInt(list, &value));
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+LL_DEFINE_LIST(BenchDouble, double)
+
+void benchPushTyped(size_t size, int type, BenchResult *result)
+{
+  BenchDoubleList *list = BenchDoubleListCreate();
+  size_t i;
+
+  (void)type;
+  benchStart(result);
+  for (i = 0; i < size; i++) BenchDoubleListPush(list, (double)i * 0.5);
+  benchStop(result, size);
+
+  BenchDoubleListDelete(list);
+}
+
+void benchDequeueTyped(size_t size, int type, BenchResult *result)
+{
+  BenchDoubleList *list = BenchDoubleListCreate();
+  double value;
+  size_t i;
+
+  (void)type;
+  for (i = 0; i < size; i++) BenchDoubleListPush(list, (double)i * 0.5);
+
+  benchStart(result);
+  while (BenchDoubleListDequeue(list, &value));
+  benchStop(result, size);
+
+  BenchDoubleListDelete(list);
+}
+
+void benchPushBatch(size_t size, int type, BenchResult *result)
+{
+  MAX_INT_TYPE *values = (MAX_INT_TYPE *)malloc(size * sizeof(MAX_INT_TYPE));
+  LinkList *list = LLCreate();
+  size_t i;
+
+  (void)type;
+  for (i = 0; i < size; i++) values[i] = (MAX_INT_TYPE)i;
+
+  benchStart(result);
+  LLPushIntegers(list, values, size, LLIN_LONG);
+  benchStop(result, size);
+
+  LLDelete(list);
+  free(values);
+}
+
+void benchDequeueBatch(size_t size, int type, BenchResult *result)
+{
+  MAX_INT_TYPE buffer[256];
+  LinkList *list = benchFill(size, type);
+
+  benchStart(result);
+  while (LLDequeueIntegers(list, buffer, 256));
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+void benchKeyedPush(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = LLCreate();
+  char key[32];
+  size_t i;
+
+  if (type) LLEnableKeyIndex(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < size; i++) LLPushKeyedInteger(list, benchKey(key, i), (MAX_INT_TYPE)i, LLIN_LONG);
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+/* Bit 1 of type selects the key index, without which lookups scan, and
+ * bit 2 case sensitive keys */
+void benchKeyedFind(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFillKeyed(size);
+  unsigned long state = 88172645463325252UL, found = 0;
+  size_t lookups = type & 1 || size < BENCH_SCAN_OPS ? size : BENCH_SCAN_OPS, i;
+  char key[32];
+
+  if (type & 1) LLEnableKeyIndex(list, Yes);
+  if (type & 2) LLEnableCaseSensitiveKeys(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < lookups; i++) found += LLFindKeyed(list, benchKey(key, benchRandom(&state) % size)) != NULL;
+  benchStop(result, lookups);
+
+  if (found != lookups) fprintf(stderr, "keyed lookups missed\n");
+  LLDelete(list);
+}
+
+/* A request handler reading four literal keys out of an indexed table;
+ * type selects hashes folded at compile time by LL_KEY_HASH */
+void benchKeyedLiteral(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFillKeyed(size);
+  unsigned long found = 0;
+  size_t i;
+
+  LLPushKeyedInteger(list, "Content-Type", 1, LLIN_LONG);
+  LLPushKeyedInteger(list, "Accept-Encoding", 2, LLIN_LONG);
+  LLPushKeyedInteger(list, "X-Request-Id", 3, LLIN_LONG);
+  LLPushKeyedInteger(list, "Authorization", 4, LLIN_LONG);
+  LLEnableKeyIndex(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < size; i++)
+  {
+    if (type)
+    {
+      found += LL_FIND_KEYED_LITERAL(list, "content-type") != NULL;
+      found += LL_FIND_KEYED_LITERAL(list, "accept-encoding") != NULL;
+      found += LL_FIND_KEYED_LITERAL(list, "x-request-id") != NULL;
+      found += LL_FIND_KEYED_LITERAL(list, "authorization") != NULL;
+    }
+    else
+    {
+      found += LLFindKeyed(list, "content-type") != NULL;
+      found += LLFindKeyed(list, "accept-encoding") != NULL;
+      found += LLFindKeyed(list, "x-request-id") != NULL;
+      found += LLFindKeyed(list, "authorization") != NULL;
+    }
+  }
+  benchStop(result, size * 4);
+
+  if (found != size * 4) fprintf(stderr, "literal lookups missed\n");
+  LLDelete(list);
+}
+
+/* Integer ids pushed as LN_INT_KEYED nodes; type selects the index */
+void benchIntKeyedPush(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = LLCreate();
+  size_t i;
+
+  if (type) LLEnableIntKeyIndex(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < size; i++) LLPushIntKeyedInteger(list, (LLIntKey)i, (MAX_INT_TYPE)i, LLIN_LONG);
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+/* As keyed_find_* with the ids compared as integers, not formatted */
+void benchIntKeyedFind(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = LLCreate();
+  unsigned long state = 88172645463325252UL, found = 0;
+  size_t lookups = type || size < BENCH_SCAN_OPS ? size : BENCH_SCAN_OPS, i;
+
+  for (i = 0; i < size; i++) LLPushIntKeyedInteger(list, (LLIntKey)i, (MAX_INT_TYPE)i, LLIN_LONG);
+  if (type) LLEnableIntKeyIndex(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < lookups; i++) found += LLFindIntKeyed(list, (LLIntKey)(benchRandom(&state) % size)) != NULL;
+  benchStop(result, lookups);
+
+  if (found != lookups) fprintf(stderr, "integer keyed lookups missed\n");
+  LLDelete(list);
+}
+
+void benchKeyedUpsert(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFillKeyed(size);
+  unsigned long state = 88172645463325252UL;
+  char key[32];
+  size_t i;
+
+  (void)type;
+  LLEnableUniqueKeys(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < size; i++) LLUpsertKeyedInteger(list, benchKey(key, benchRandom(&state) % size), (MAX_INT_TYPE)i, LLIN_LONG);
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+/* type selects the data index; without it each removal scans. Removed
+ * nodes are left to the caller by LLRemoveByData and so are not freed. */
+void benchRemoveByData(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFill(size, LN_VOID);
+  size_t removals = type || size < BENCH_SCAN_OPS ? size : BENCH_SCAN_OPS, i;
+
+  if (type) LLEnableDataIndex(list, Yes);
+
+  /* Strided so removals land all over the list rather than at its head */
+  benchStart(result);
+  for (i = 0; i < removals; i++) LLRemoveByData(list, benchPointer(i * 7919 % size));
+  benchStop(result, removals);
+
+  LLDelete(list);
+}
+
+void benchDelete(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFill(size, type);
+
+  benchStart(result);
+  LLDelete(list);
+  benchStop(result, size);
+}
+
+/* A work queue holding size items: each step pushes one, dequeues one */
+void benchMixedQueue(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFill(size, type);
+  LinkNode *node;
+  size_t i;
+
+  benchStart(result);
+  for (i = 0; i < size; i++)
+  {
+    benchPush(list, type, i);
+    if ((node = LLDequeueNode(list)) != NULL) LNDelete(node);
+  }
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+/* The work queue with aggregates kept and read back every 1024 steps; the
+ * oldest, smallest value leaves each step so every read rescans min */
+void benchMixedAggregates(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFill(size, type);
+  LLAggregates aggregates;
+  LinkNode *node;
+  size_t i;
+
+  LLEnableAggregates(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < size; i++)
+  {
+    benchPush(list, type, size + i);
+    if ((node = LLDequeueNode(list)) != NULL) LNDelete(node);
+    if (i % 1024 == 1023) LLGetAggregates(list, &aggregates);
+  }
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+/* A keyed table under a read mostly load: four lookups per upsert */
+void benchMixedKeyed(size_t size, int type, BenchResult *result)
+{
+  LinkList *list = benchFillKeyed(size);
+  unsigned long state = 88172645463325252UL;
+  char key[32];
+  size_t i;
+
+  (void)type;
+  LLEnableUniqueKeys(list, Yes);
+
+  benchStart(result);
+  for (i = 0; i < size; i++)
+  {
+    benchKey(key, benchRandom(&state) % size);
+    if (i % 5 == 4) LLUpsertKeyedInteger(list, key, (MAX_INT_TYPE)i, LLIN_LONG);
+    else LLFindKeyed(list, key);
+  }
+  benchStop(result, size);
+
+  LLDelete(list);
+}
+
+BenchCase benchCases[] = {
+  { "push_boolean", benchPushType, LN_BOOLEAN },
+  { "push_integer", benchPushType, LN_INTEGER },
+  { "push_decimal", benchPushType, LN_DECIMAL },
+  { "push_string", benchPushType, LN_STRING },
+  { "push_void", benchPushType, LN_VOID },
+  { "pop_boolean", benchPopType, LN_BOOLEAN },
+  { "pop_integer", benchPopType, LN_INTEGER },
+  { "pop_decimal", benchPopType, LN_DECIMAL },
+  { "pop_string", benchPopType, LN_STRING },
+  { "pop_void", benchPopType, LN_VOID },
+  { "dequeue_boolean", benchDequeueType, LN_BOOLEAN },
+  { "dequeue_integer", benchDequeueType, LN_INTEGER },
+  { "dequeue_decimal", benchDequeueType, LN_DECIMAL },
+  { "dequeue_string", benchDequeueType, LN_STRING },
+  { "dequeue_void", benchDequeueType, LN_VOID },
+  { "push_int_method", benchPushInt, 0 },
+  { "push_int_inline", benchPushInt, 1 },
+  { "pop_int_inline", benchPopIntInline, LN_INTEGER },
+  { "dequeue_int_inline", benchDequeueIntInline, LN_INTEGER },
+  { "push_typed_double", benchPushTyped, 0 },
+  { "dequeue_typed_double", benchDequeueTyped, 0 },
+  { "push_batch_integer", benchPushBatch, LN_INTEGER },
+  { "dequeue_batch_integer", benchDequeueBatch, LN_INTEGER },
+  { "keyed_push", benchKeyedPush, 0 },
+  { "keyed_push_indexed", benchKeyedPush, 1 },
+  { "keyed_find_scan", benchKeyedFind, 0 },
+  { "keyed_find_indexed", benchKeyedFind, 1 },
+  { "keyed_find_scan_exact", benchKeyedFind, 2 },
+  { "keyed_find_indexed_exact", benchKeyedFind, 3 },
+  { "keyed_find_literal", benchKeyedLiteral, 0 },
+  { "keyed_find_literal_hashed", benchKeyedLiteral, 1 },
+  { "int_keyed_push", benchIntKeyedPush, 0 },
+  { "int_keyed_push_indexed", benchIntKeyedPush, 1 },
+  { "int_keyed_find_scan", benchIntKeyedFind, 0 },
+  { "int_keyed_find_indexed", benchIntKeyedFind, 1 },
+  { "keyed_upsert_unique", benchKeyedUpsert, 0 },
+  { "remove_by_data_scan", benchRemoveByData, 0 },
+  { "remove_by_data_indexed", benchRemoveByData, 1 },
+  { "delete_integer", benchDelete, LN_INTEGER },
+  { "delete_string", benchDelete, LN_STRING },
+  { "mixed_queue", benchMixedQueue, LN_INTEGER },
+  { "mixed_queue_aggregates", benchMixedAggregates, LN_INTEGER },
+  { "mixed_keyed", benchMixedKeyed, 0 }
+};
+
+#pragma mark - Driver
+
+void benchRun(BenchCase *benchCase, size_t size, BenchResult *result)
+{
+  size_t repetitions = size >= BENCH_MIN_OPS ? 1 : BENCH_MIN_OPS / size, i;
+  #ifdef BENCH_FORK
+  struct rusage usage;
+  #endif
+
+  memset(result, 0L, sizeof(BenchResult));
+  for (i = 0; i < repetitions; i++) benchCase->run(size, benchCase->type, result);
+
+  #ifdef BENCH_FORK
+  getrusage(RUSAGE_SELF, &usage);
+  #ifdef __APPLE__
+  result->peakRssKb = usage.ru_maxrss / 1024;
+  #else
+  result->peakRssKb = usage.ru_maxrss;
+  #endif
+  #else
+  result->peakRssKb = -1;
+  #endif
+}
+
+/* Runs the case in a child when possible so its peak RSS is its own */
+LLBoolean benchMeasure(BenchCase *benchCase, size_t size, BenchResult *result)
+{
+  #ifdef BENCH_FORK
+  int channel[2], status;
+  pid_t child;
+
+  if (pipe(channel) != 0) return No;
+
+  fflush(stdout);
+  child = fork();
+  if (child == 0)
+  {
+    close(channel[0]);
+    benchRun(benchCase, size, result);
+    _exit(write(channel[1], result, sizeof(BenchResult)) == sizeof(BenchResult) ? 0 : 1);
+  }
+
+  close(channel[1]);
+  status = child > 0 && read(channel[0], result, sizeof(BenchResult)) == sizeof(BenchResult);
+  close(channel[0]);
+  if (child > 0) waitpid(child, NULL, 0);
+  return status ? Yes : No;
+  #else
+  benchRun(benchCase, size, result);
+  return Yes;
+  #endif
+}
+
+int main(int argc, char **argv)
+{
+  size_t maxSize = argc > 1 ? (size_t)atol(argv[1]) : 10000000;
+  const char *filter = argc > 2 ? argv[2] : NULL;
+  size_t size, i, cases = sizeof(benchCases) / sizeof(BenchCase);
+  const char *separator = "";
+  BenchResult result;
+
+  printf("{ \"benchmarks\": [");
+  for (size = 10; size <= maxSize; size *= 10)
+  {
+    for (i = 0; i < cases; i++)
+    {
+      if (filter && !strstr(benchCases[i].name, filter)) continue;
+      if (!benchMeasure(&benchCases[i], size, &result) || !result.ops) continue;
+
+      printf("%s\n  { \"name\": \"%s\", \"size\": %lu, \"ops\": %.0f, \"nsPerOp\": %.1f, ",
+        separator, benchCases[i].name, (unsigned long)size, result.ops, result.seconds / result.ops * 1e9);
+      #ifdef LL_BENCH_WRAP
+      printf("\"allocsPerOp\": %.2f, ", result.allocs / result.ops);
+      #else
+      printf("\"allocsPerOp\": null, ");
+      #endif
+      printf("\"peakRssKb\": %ld }", result.peakRssKb);
+
+      separator = ",";
+      fflush(stdout);
+    }
+  }
+  printf("\n] }\n");
+  return 0;
+}
@@ -0,0 +1,135 @@
+/* Loads a generated CSV file with LLLoadFile and with the fgets, strtol
+ * and per-field push loop it replaces, reporting throughput for each.
+ * Rows look like telemetry: an id, a millisecond timestamp, a reading
+ * with two decimals and a short tag.
+ *
+ *   ll_bench_load generate <path> [megabytes]
+ *   ll_bench_load [path]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "LLLoad.h"
+
+#define BENCH_DEFAULT_PATH "ll_bench_load.csv"
+
+double benchSeconds(void)
+{
+  struct timeval now;
+
+  gettimeofday(&now, NULL);
+  return now.tv_sec + now.tv_usec / 1e6;
+}
+
+unsigned long benchRandom(unsigned long *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+int benchGenerate(const char *path, size_t megabytes)
+{
+  static const char *tags[] = { "ok", "warn", "error", "retry", "timeout", "idle" };
+  unsigned long state = 2463534242UL, reading;
+  long timestamp = 1700000000000L, id = 0;
+  FILE *file = fopen(path, "w");
+
+  if (!file) return 1;
+
+  fprintf(file, "id,timestamp,reading,tag\n");
+  while ((size_t)ftell(file) < megabytes << 20)
+  {
+    timestamp += 1 + (long)(benchRandom(&state) % 50);
+    reading = benchRandom(&state) % 1000000;
+    fprintf(file, "%ld,%ld,%lu.%02lu,%s\n", id++, timestamp, reading / 100, reading % 100,
+      tags[benchRandom(&state) % 6]);
+  }
+
+  fclose(file);
+  return 0;
+}
+
+/* The loop LLLoadFile replaces */
+long benchBaseline(LinkList *list, const char *path)
+{
+  char line[4096], *names[16], *field, *next, *end;
+  FILE *file = fopen(path, "r");
+  long pushed = 0, value;
+  double decimal;
+  int columns = 0, column;
+
+  if (!file || !fgets(line, sizeof(line), file)) return -1;
+
+  for (field = strtok(line, ",\r\n"); field && columns < 16; field = strtok(NULL, ",\r\n"))
+  {
+    names[columns++] = strdup(field);
+  }
+
+  while (fgets(line, sizeof(line), file))
+  {
+    line[strcspn(line, "\r\n")] = '\0';
+    for (field = line, column = 0; field && column < columns; field = next, column++)
+    {
+      next = strchr(field, ',');
+      if (next) *next++ = '\0';
+
+      value = strtol(field, &end, 10);
+      if (*field && !*end) LLPushKeyedInteger(list, names[column], value, LLIN_LONG);
+      else if ((decimal = strtod(field, &end)), *field && !*end) LLPushKeyedDecimal(list, names[column], decimal, LLDN_DOUBLE);
+      else LLPushKeyedString(list, names[column], field, LLSN_STRING);
+      pushed++;
+    }
+  }
+
+  while (columns) free(names[--columns]);
+  fclose(file);
+  return pushed;
+}
+
+int main(int argc, char **argv)
+{
+  LLLoadOptions options = { ',', Yes, Yes };
+  const char *path = argc > 1 ? argv[1] : BENCH_DEFAULT_PATH;
+  double start, loadSeconds, baselineSeconds, gigabytes;
+  long loaded, baseline;
+  LinkList *list;
+  FILE *file;
+
+  if (argc > 2 && strcmp(argv[1], "generate") == 0)
+  {
+    return benchGenerate(argv[2], argc > 3 ? (size_t)atol(argv[3]) : 256);
+  }
+
+  if (!(file = fopen(path, "r")))
+  {
+    if (argc > 1 || benchGenerate(path, 256) != 0) return 1;
+    file = fopen(path, "r");
+  }
+  fseek(file, 0L, SEEK_END);
+  gigabytes = ftell(file) / 1e9;
+  fclose(file);
+
+  list = LLCreate();
+  start = benchSeconds();
+  loaded = LLLoadFile(list, path, &options);
+  loadSeconds = benchSeconds() - start;
+  LLDelete(list);
+
+  list = LLCreate();
+  start = benchSeconds();
+  baseline = benchBaseline(list, path);
+  baselineSeconds = benchSeconds() - start;
+  LLDelete(list);
+
+  printf("{ \"bytes\": %.0f,\n", gigabytes * 1e9);
+  printf("  \"LLLoadFile\": { \"nodes\": %ld, \"seconds\": %.3f, \"gbPerSecond\": %.2f },\n",
+    loaded, loadSeconds, gigabytes / loadSeconds);
+  printf("  \"fgets\": { \"nodes\": %ld, \"seconds\": %.3f, \"gbPerSecond\": %.2f } }\n",
+    baseline, baselineSeconds, gigabytes / baselineSeconds);
+
+  return 0;
+}